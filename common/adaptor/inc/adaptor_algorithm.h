@@ -27,14 +27,34 @@ typedef struct {
     Buffer *priKey;
 } KeyPair;
 
+// A keyed HMAC state, reused so that each MAC starts from a copy instead of a fresh key schedule.
+typedef struct HmacContext HmacContext;
+
+// A parsed public key, kept by the owner of the raw key so that each verify skips the key import.
+typedef struct Ed25519PublicKey Ed25519PublicKey;
+
 bool IsEd25519KeyPairValid(const KeyPair *keyPair);
 void DestoryKeyPair(KeyPair *keyPair);
 KeyPair *GenerateEd25519KeyPair(void);
-int32_t Ed25519Sign(const KeyPair *keyPair, const Buffer *data, Buffer **sign);
+// Writes into sign, which needs room for ED25519_FIX_SIGN_BUFFER_SIZE bytes, a BUFFER_INLINE in C callers.
+int32_t Ed25519Sign(const KeyPair *keyPair, const Buffer *data, Buffer *sign);
 int32_t Ed25519Verify(const Buffer *pubKey, const Buffer *data, const Buffer *sign);
+Ed25519PublicKey *CreateEd25519PublicKey(const uint8_t *pubKey, uint32_t pubKeySize);
+void DestroyEd25519PublicKey(Ed25519PublicKey *publicKey);
+int32_t Ed25519VerifyWithKey(const Ed25519PublicKey *publicKey, const Buffer *data, const Buffer *sign);
 
 int32_t HmacSha256(const Buffer *hmacKey, const Buffer *data, Buffer **hmac);
+HmacContext *CreateHmacSha256Context(const Buffer *hmacKey);
+void DestroyHmacContext(HmacContext *context);
+int32_t HmacSha256WithContext(HmacContext *context, const uint8_t *data, uint32_t dataSize,
+    uint8_t *hmac, uint32_t hmacSize);
+int32_t HmacSha256VerifyWithContext(HmacContext *context, const uint8_t *data, uint32_t dataSize,
+    const uint8_t *hmac, uint32_t hmacSize);
+// Compares in time that depends only on size, for MACs and other secrets.
+bool SecureCompare(const uint8_t *data1, const uint8_t *data2, uint32_t size);
 int32_t SecureRandom(uint8_t *buffer, uint32_t size);
+// Drops the buffered random bytes, the next small request refills from the provider.
+void ResetSecureRandomPool(void);
 
 #endif
 
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ADAPTOR_CRYPTO_H
+#define ADAPTOR_CRYPTO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "adaptor_algorithm.h"
+#include "buffer.h"
+#include "defines.h"
+
+typedef enum CryptoProviderType {
+    DEFAULT_CRYPTO_PROVIDER,
+} CryptoProviderType;
+
+// Parameters are checked by adaptor_algorithm before they reach a provider.
+typedef struct CryptoProvider {
+    const char *name;
+    int32_t (*generateEd25519KeyPair)(KeyPair *keyPair);
+    int32_t (*ed25519Sign)(const KeyPair *keyPair, const Buffer *data, Buffer *sign);
+    int32_t (*ed25519Verify)(const Buffer *pubKey, const Buffer *data, const Buffer *sign);
+    Ed25519PublicKey *(*createEd25519PublicKey)(const uint8_t *pubKey, uint32_t pubKeySize);
+    void (*destroyEd25519PublicKey)(Ed25519PublicKey *publicKey);
+    int32_t (*ed25519VerifyWithKey)(const Ed25519PublicKey *publicKey, const Buffer *data, const Buffer *sign);
+    int32_t (*hmacSha256)(const Buffer *hmacKey, const Buffer *data, Buffer *hmac);
+    HmacContext *(*createHmacSha256Context)(const Buffer *hmacKey);
+    void (*destroyHmacContext)(HmacContext *context);
+    int32_t (*hmacSha256WithContext)(HmacContext *context, const uint8_t *data, uint32_t dataSize,
+        uint8_t *hmac, uint32_t hmacSize);
+    int32_t (*secureRandom)(uint8_t *buffer, uint32_t size);
+} CryptoProvider;
+
+bool IsCryptoProviderValid(const CryptoProvider *provider);
+CryptoProvider *GetCryptoProvider(const CryptoProviderType type);
+// Keys and contexts belong to the provider that created them, so switch only before any is created.
+ResultCode SetCryptoProvider(const CryptoProvider *provider);
+const CryptoProvider *GetCurrentCryptoProvider(void);
+
+#endif
@@ -27,6 +27,8 @@ typedef struct FileOperator {
     bool (*isFileExist)(const char *fileName);
     int32_t (*getFileLen)(const char *fileName, uint32_t *len);
     int32_t (*readFile)(const char *fileName, uint8_t *buf, uint32_t len);
+    // Optional, the whole file is read instead when it is NULL.
+    int32_t (*readFileByOffset)(const char *fileName, uint32_t offset, uint8_t *buf, uint32_t len);
     int32_t (*writeFile)(const char *fileName, const uint8_t *buf, uint32_t len);
     int32_t (*deleteFile)(const char *fileName);
 } FileOperator;
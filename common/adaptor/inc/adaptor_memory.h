@@ -17,9 +17,61 @@
 #define ADAPTOR_MEMORY_H
 
 #include <stddef.h>
+#include <stdint.h>
+
+#define MAX_MEMORY_SITE_NUM 64
+
+typedef struct MemoryStats {
+    uint64_t liveBytes;
+    uint64_t peakBytes;
+    uint64_t mallocCount;
+    uint64_t freeCount;
+} MemoryStats;
+
+typedef struct MemorySiteStats {
+    const char *site;
+    uint64_t mallocCount;
+    uint64_t mallocBytes;
+} MemorySiteStats;
 
 void *Malloc(const size_t size);
 
 void Free(void *ptr);
 
+// Small blocks are recycled through per size class free lists, every block is wiped on release.
+// Blocks must be released with PoolFree and the size they were requested with.
+void *PoolMalloc(const size_t size);
+
+void PoolFree(void *ptr, const size_t size);
+
+void DestroyMemoryPool(void);
+
+// Scratch arena for one HAL call, each thread has its own. ArenaMalloc memory is released at once by the outermost
+// EndMemoryArena of the thread, Free and PoolFree on it only wipe, and it must not be handed to another thread.
+// Without an open arena ArenaMalloc is PoolMalloc.
+void BeginMemoryArena(void);
+
+void EndMemoryArena(void);
+
+void *ArenaMalloc(const size_t size);
+
+// Statistics are only collected when built with MEMORY_STATS, otherwise they stay zero. Live and peak bytes
+// count heap blocks held by the C core, pooled and arena blocks included. Allocations are counted per calling
+// function of Malloc, PoolMalloc and ArenaMalloc.
+void *MallocFromSite(const size_t size, const char *site);
+
+void *PoolMallocFromSite(const size_t size, const char *site);
+
+void *ArenaMallocFromSite(const size_t size, const char *site);
+
+void GetMemoryStats(MemoryStats *stats);
+
+uint32_t GetMemorySiteStats(MemorySiteStats *sites, uint32_t maxNum);
+
+#ifdef MEMORY_STATS
+#define Malloc(size) MallocFromSite((size), __func__)
+#define PoolMalloc(size) PoolMallocFromSite((size), __func__)
+#define ArenaMalloc(size) ArenaMallocFromSite((size), __func__)
+#endif
+
 #endif
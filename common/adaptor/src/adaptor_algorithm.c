@@ -14,16 +14,15 @@
  */
 
 #include "adaptor_algorithm.h"
-#include <openssl/evp.h>
-#include <openssl/hmac.h>
-#include <openssl/rand.h>
+#include <pthread.h>
+#include <openssl/crypto.h>
+#include "securec.h"
+#include "adaptor_crypto.h"
 #include "adaptor_log.h"
 #include "adaptor_memory.h"
 #include "buffer.h"
 #include "defines.h"
 
-#define OPENSSL_SUCCESS 1
-
 #define ED25519_FIX_PRIKEY_BUFFER_SIZE 32
 #define ED25519_FIX_PUBKEY_BUFFER_SIZE 32
 #define ED25519_FIX_SIGN_BUFFER_SIZE 64
@@ -31,6 +30,16 @@
 #define SHA256_DIGEST_SIZE 32
 #define SHA512_DIGEST_SIZE 64
 
+#define RANDOM_POOL_SIZE 512
+#define RANDOM_POOL_MAX_REQUEST 16
+
+// Random bytes fetched in one block and handed out to the small id and challenge requests.
+// Served bytes are wiped, and the pool is dropped on fork so a child never repeats the parent's values.
+static pthread_mutex_t g_randomPoolMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t g_randomPoolOnce = PTHREAD_ONCE_INIT;
+static uint8_t g_randomPool[RANDOM_POOL_SIZE];
+static uint32_t g_randomPoolLeft = 0;
+
 static KeyPair *CreateEd25519KeyPair()
 {
     KeyPair *keyPair = Malloc(sizeof(KeyPair));
@@ -92,89 +101,27 @@ KeyPair *GenerateEd25519KeyPair(void)
         LOG_ERROR("create key pair failed");
         return NULL;
     }
-    EVP_PKEY *key = NULL;
-    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, NULL);
-    if (ctx == NULL) {
-        LOG_ERROR("new ctx failed");
-        goto ERROR;
-    }
-    if (EVP_PKEY_keygen_init(ctx) != OPENSSL_SUCCESS) {
-        LOG_ERROR("init ctx failed");
-        goto ERROR;
-    }
-    if (EVP_PKEY_keygen(ctx, &key) != OPENSSL_SUCCESS) {
-        LOG_ERROR("generate key failed");
-        goto ERROR;
-    }
-    size_t pubKeySize = keyPair->pubKey->maxSize;
-    if (EVP_PKEY_get_raw_public_key(key, keyPair->pubKey->buf, &pubKeySize) != OPENSSL_SUCCESS) {
-        LOG_ERROR("get public key failed");
-        goto ERROR;
-    }
-    keyPair->pubKey->contentSize = pubKeySize;
-    size_t priKeySize = keyPair->priKey->maxSize;
-    if (EVP_PKEY_get_raw_private_key(key, keyPair->priKey->buf, &priKeySize) != OPENSSL_SUCCESS) {
-        LOG_ERROR("get private key failed");
-        goto ERROR;
-    }
-    keyPair->priKey->contentSize = priKeySize;
-    goto EXIT;
-
-ERROR:
-    DestoryKeyPair(keyPair);
-    keyPair = NULL;
-EXIT:
-    if (key != NULL) {
-        EVP_PKEY_free(key);
-    }
-    if (ctx != NULL) {
-        EVP_PKEY_CTX_free(ctx);
+    if (GetCurrentCryptoProvider()->generateEd25519KeyPair(keyPair) != RESULT_SUCCESS) {
+        LOG_ERROR("generate key pair failed");
+        DestoryKeyPair(keyPair);
+        return NULL;
     }
     return keyPair;
 }
 
-int32_t Ed25519Sign(const KeyPair *keyPair, const Buffer *data, Buffer **sign)
+int32_t Ed25519Sign(const KeyPair *keyPair, const Buffer *data, Buffer *sign)
 {
-    if (!IsEd25519KeyPairValid(keyPair) || !IsBufferValid(data) || sign == NULL) {
+    if (!IsEd25519KeyPairValid(keyPair) || !IsBufferValid(data) || !IsBufferValid(sign) ||
+        sign->maxSize < ED25519_FIX_SIGN_BUFFER_SIZE) {
         LOG_ERROR("invalid params");
         return RESULT_BAD_PARAM;
     }
-    int32_t ret = RESULT_GENERAL_ERROR;
-    EVP_PKEY *key = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL,
-        keyPair->priKey->buf, keyPair->priKey->contentSize);
-    if (key == NULL) {
-        LOG_ERROR("get private key failed");
-        return ret;
-    }
-    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
-    if (ctx == NULL) {
-        LOG_ERROR("get ctx failed");
-        EVP_PKEY_free(key);
-        return ret;
-    }
-    if (EVP_DigestSignInit(ctx, NULL, NULL, NULL, key) != OPENSSL_SUCCESS) {
-        LOG_ERROR("init sign failed");
-        goto EXIT;
-    }
-    *sign = CreateBuffer(ED25519_FIX_SIGN_BUFFER_SIZE);
-    if (!IsBufferValid(*sign)) {
-        LOG_ERROR("create buffer failed");
-        goto EXIT;
-    }
-    size_t signSize = (*sign)->maxSize;
-    if (EVP_DigestSign(ctx, (*sign)->buf, &signSize, data->buf, data->contentSize) != OPENSSL_SUCCESS) {
+    if (GetCurrentCryptoProvider()->ed25519Sign(keyPair, data, sign) != RESULT_SUCCESS) {
         LOG_ERROR("sign failed");
-        DestoryBuffer(*sign);
-        *sign = NULL;
-        goto EXIT;
+        sign->contentSize = 0;
+        return RESULT_GENERAL_ERROR;
     }
-    (*sign)->contentSize = signSize;
-    ret = RESULT_SUCCESS;
-
-EXIT:
-    EVP_PKEY_free(key);
-    EVP_MD_CTX_free(ctx);
-    return ret;
+    return RESULT_SUCCESS;
 }
 
 int32_t Ed25519Verify(const Buffer *pubKey, const Buffer *data, const Buffer *sign)
@@ -184,69 +131,47 @@ int32_t Ed25519Verify(const Buffer *pubKey, const Buffer *data, const Buffer *si
         LOG_ERROR("bad param");
         return RESULT_BAD_PARAM;
     }
-    int32_t ret = RESULT_GENERAL_ERROR;
-    EVP_PKEY *key = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, NULL, pubKey->buf, pubKey->contentSize);
-    if (key == NULL) {
-        LOG_ERROR("get public key failed");
-        return ret;
-    }
-    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
-    if (ctx == NULL) {
-        LOG_ERROR("get ctx failed");
-        EVP_PKEY_free(key);
-        return ret;
-    }
-    if (EVP_DigestVerifyInit(ctx, NULL, NULL, NULL, key) != OPENSSL_SUCCESS) {
-        LOG_ERROR("init verify failed");
-        goto EXIT;
-    }
-    if (EVP_DigestVerify(ctx, sign->buf, sign->contentSize, data->buf, data->contentSize) != OPENSSL_SUCCESS) {
-        LOG_ERROR("verify failed");
-        goto EXIT;
+    return GetCurrentCryptoProvider()->ed25519Verify(pubKey, data, sign);
+}
+
+Ed25519PublicKey *CreateEd25519PublicKey(const uint8_t *pubKey, uint32_t pubKeySize)
+{
+    if (pubKey == NULL || pubKeySize != ED25519_FIX_PUBKEY_BUFFER_SIZE) {
+        LOG_ERROR("bad param");
+        return NULL;
     }
-    ret = RESULT_SUCCESS;
+    return GetCurrentCryptoProvider()->createEd25519PublicKey(pubKey, pubKeySize);
+}
 
-EXIT:
-    EVP_PKEY_free(key);
-    EVP_MD_CTX_free(ctx);
-    return ret;
+void DestroyEd25519PublicKey(Ed25519PublicKey *publicKey)
+{
+    if (publicKey == NULL) {
+        return;
+    }
+    GetCurrentCryptoProvider()->destroyEd25519PublicKey(publicKey);
 }
 
-static int32_t IamHmac(const EVP_MD *alg, const Buffer *hmacKey, const Buffer *data, Buffer *hmac)
+int32_t Ed25519VerifyWithKey(const Ed25519PublicKey *publicKey, const Buffer *data, const Buffer *sign)
 {
-    if (!IsBufferValid(hmacKey) || hmacKey->contentSize > INT_MAX ||
-        !IsBufferValid(data) || !IsBufferValid(hmac) || hmac->maxSize > UINT_MAX) {
+    if (publicKey == NULL || !IsBufferValid(data) || !CheckBufferWithSize(sign, ED25519_FIX_SIGN_BUFFER_SIZE)) {
         LOG_ERROR("bad param");
         return RESULT_BAD_PARAM;
     }
-    uint32_t hmacSize = hmac->maxSize;
-    uint8_t *hmacData = HMAC(alg, hmacKey->buf, (int)hmacKey->contentSize, data->buf, data->contentSize,
-        hmac->buf, &hmacSize);
-    if (hmacData == NULL) {
-        LOG_ERROR("hmac failed");
-        return RESULT_GENERAL_ERROR;
-    }
-    hmac->contentSize = hmacSize;
-    return RESULT_SUCCESS;
+    return GetCurrentCryptoProvider()->ed25519VerifyWithKey(publicKey, data, sign);
 }
 
 int32_t HmacSha256(const Buffer *hmacKey, const Buffer *data, Buffer **hmac)
 {
-    if (hmac == NULL) {
-        LOG_ERROR("hmac is null");
+    if (!IsBufferValid(hmacKey) || hmacKey->contentSize > INT_MAX || !IsBufferValid(data) || hmac == NULL) {
+        LOG_ERROR("bad param");
         return RESULT_BAD_PARAM;
     }
-    const EVP_MD *alg = EVP_sha256();
-    if (alg == NULL) {
-        LOG_ERROR("no algo");
-        return RESULT_GENERAL_ERROR;
-    }
     *hmac = CreateBuffer(SHA256_DIGEST_SIZE);
     if (*hmac == NULL) {
         LOG_ERROR("create buffer failed");
         return RESULT_NO_MEMORY;
     }
-    if (IamHmac(alg, hmacKey, data, *hmac) != RESULT_SUCCESS) {
+    if (GetCurrentCryptoProvider()->hmacSha256(hmacKey, data, *hmac) != RESULT_SUCCESS) {
         DestoryBuffer(*hmac);
         *hmac = NULL;
         LOG_ERROR("hmac failed");
@@ -255,15 +180,125 @@ int32_t HmacSha256(const Buffer *hmacKey, const Buffer *data, Buffer **hmac)
     return RESULT_SUCCESS;
 }
 
+HmacContext *CreateHmacSha256Context(const Buffer *hmacKey)
+{
+    if (!IsBufferValid(hmacKey) || hmacKey->contentSize > INT_MAX) {
+        LOG_ERROR("bad param");
+        return NULL;
+    }
+    return GetCurrentCryptoProvider()->createHmacSha256Context(hmacKey);
+}
+
+void DestroyHmacContext(HmacContext *context)
+{
+    if (context == NULL) {
+        return;
+    }
+    GetCurrentCryptoProvider()->destroyHmacContext(context);
+}
+
+int32_t HmacSha256WithContext(HmacContext *context, const uint8_t *data, uint32_t dataSize,
+    uint8_t *hmac, uint32_t hmacSize)
+{
+    if (context == NULL || data == NULL || hmac == NULL || hmacSize < SHA256_DIGEST_SIZE) {
+        LOG_ERROR("bad param");
+        return RESULT_BAD_PARAM;
+    }
+    return GetCurrentCryptoProvider()->hmacSha256WithContext(context, data, dataSize, hmac, hmacSize);
+}
+
+int32_t HmacSha256VerifyWithContext(HmacContext *context, const uint8_t *data, uint32_t dataSize,
+    const uint8_t *hmac, uint32_t hmacSize)
+{
+    if (hmac == NULL || hmacSize != SHA256_DIGEST_SIZE) {
+        LOG_ERROR("bad param");
+        return RESULT_BAD_PARAM;
+    }
+    uint8_t rightHmac[SHA256_DIGEST_SIZE];
+    int32_t ret = HmacSha256WithContext(context, data, dataSize, rightHmac, SHA256_DIGEST_SIZE);
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("hmac failed");
+        return ret;
+    }
+    if (!SecureCompare(rightHmac, hmac, SHA256_DIGEST_SIZE)) {
+        ret = RESULT_BAD_SIGN;
+    }
+    (void)memset_s(rightHmac, SHA256_DIGEST_SIZE, 0, SHA256_DIGEST_SIZE);
+    return ret;
+}
+
+bool SecureCompare(const uint8_t *data1, const uint8_t *data2, uint32_t size)
+{
+    if (data1 == NULL || data2 == NULL) {
+        return false;
+    }
+    return CRYPTO_memcmp(data1, data2, size) == 0;
+}
+
+// The pool is locked across fork, so the child never inherits it in the middle of a refill or a copy.
+static void LockRandomPoolBeforeFork(void)
+{
+    (void)pthread_mutex_lock(&g_randomPoolMutex);
+}
+
+static void UnlockRandomPoolInParent(void)
+{
+    (void)pthread_mutex_unlock(&g_randomPoolMutex);
+}
+
+static void DropRandomPoolInChild(void)
+{
+    (void)memset_s(g_randomPool, RANDOM_POOL_SIZE, 0, RANDOM_POOL_SIZE);
+    g_randomPoolLeft = 0;
+    (void)pthread_mutex_init(&g_randomPoolMutex, NULL);
+}
+
+static void RegisterRandomPoolForkHandler(void)
+{
+    if (pthread_atfork(LockRandomPoolBeforeFork, UnlockRandomPoolInParent, DropRandomPoolInChild) != 0) {
+        LOG_ERROR("register fork handler failed");
+    }
+}
+
+void ResetSecureRandomPool(void)
+{
+    (void)pthread_mutex_lock(&g_randomPoolMutex);
+    (void)memset_s(g_randomPool, RANDOM_POOL_SIZE, 0, RANDOM_POOL_SIZE);
+    g_randomPoolLeft = 0;
+    (void)pthread_mutex_unlock(&g_randomPoolMutex);
+}
+
 int32_t SecureRandom(uint8_t *buffer, uint32_t size)
 {
     if (buffer == NULL || size > INT_MAX) {
         LOG_ERROR("bad param");
         return RESULT_BAD_PARAM;
     }
-    if (RAND_bytes(buffer, (int)size) != OPENSSL_SUCCESS) {
-        LOG_ERROR("rand failed");
-        return RESULT_GENERAL_ERROR;
-    }
+    if (size == 0) {
+        return RESULT_SUCCESS;
+    }
+    if (size > RANDOM_POOL_MAX_REQUEST) {
+        return GetCurrentCryptoProvider()->secureRandom(buffer, size);
+    }
+    (void)pthread_once(&g_randomPoolOnce, RegisterRandomPoolForkHandler);
+    (void)pthread_mutex_lock(&g_randomPoolMutex);
+    if (g_randomPoolLeft < size) {
+        if (GetCurrentCryptoProvider()->secureRandom(g_randomPool, RANDOM_POOL_SIZE) != RESULT_SUCCESS) {
+            LOG_ERROR("refill random pool failed");
+            g_randomPoolLeft = 0;
+            (void)pthread_mutex_unlock(&g_randomPoolMutex);
+            return RESULT_GENERAL_ERROR;
+        }
+        g_randomPoolLeft = RANDOM_POOL_SIZE;
+    }
+    uint8_t *served = g_randomPool + (RANDOM_POOL_SIZE - g_randomPoolLeft);
+    if (memcpy_s(buffer, size, served, size) != EOK) {
+        LOG_ERROR("copy random failed");
+        (void)pthread_mutex_unlock(&g_randomPoolMutex);
+        return RESULT_BAD_COPY;
+    }
+    (void)memset_s(served, size, 0, size);
+    g_randomPoolLeft -= size;
+    (void)pthread_mutex_unlock(&g_randomPoolMutex);
     return RESULT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "adaptor_crypto.h"
+#include <pthread.h>
+#include <stddef.h>
+#include "adaptor_log.h"
+#include "crypto_provider.h"
+
+// Backend behind adaptor_algorithm, the default provider is used until another one is set.
+static const CryptoProvider *g_cryptoProvider = NULL;
+static pthread_once_t g_cryptoProviderOnce = PTHREAD_ONCE_INIT;
+
+bool IsCryptoProviderValid(const CryptoProvider *provider)
+{
+    if (provider == NULL) {
+        LOG_ERROR("get null crypto provider");
+        return false;
+    }
+    if (provider->generateEd25519KeyPair == NULL || provider->ed25519Sign == NULL ||
+        provider->ed25519Verify == NULL) {
+        LOG_ERROR("get null ed25519 operation");
+        return false;
+    }
+    if (provider->createEd25519PublicKey == NULL || provider->destroyEd25519PublicKey == NULL ||
+        provider->ed25519VerifyWithKey == NULL) {
+        LOG_ERROR("get null ed25519 key operation");
+        return false;
+    }
+    if (provider->hmacSha256 == NULL || provider->createHmacSha256Context == NULL ||
+        provider->destroyHmacContext == NULL || provider->hmacSha256WithContext == NULL) {
+        LOG_ERROR("get null hmac operation");
+        return false;
+    }
+    if (provider->secureRandom == NULL) {
+        LOG_ERROR("get null random operation");
+        return false;
+    }
+    return true;
+}
+
+CryptoProvider *GetCryptoProvider(const CryptoProviderType type)
+{
+    if (type == DEFAULT_CRYPTO_PROVIDER) {
+        LOG_INFO("get default crypto provider");
+        return GetDefaultCryptoProvider();
+    }
+    return NULL;
+}
+
+static void InitCryptoProvider(void)
+{
+    if (g_cryptoProvider == NULL) {
+        g_cryptoProvider = GetDefaultCryptoProvider();
+    }
+}
+
+ResultCode SetCryptoProvider(const CryptoProvider *provider)
+{
+    if (!IsCryptoProviderValid(provider)) {
+        LOG_ERROR("invalid crypto provider");
+        return RESULT_BAD_PARAM;
+    }
+    (void)pthread_once(&g_cryptoProviderOnce, InitCryptoProvider);
+    g_cryptoProvider = provider;
+    ResetSecureRandomPool();
+    return RESULT_SUCCESS;
+}
+
+const CryptoProvider *GetCurrentCryptoProvider(void)
+{
+    (void)pthread_once(&g_cryptoProviderOnce, InitCryptoProvider);
+    return g_cryptoProvider;
+}
@@ -14,21 +14,339 @@
  */
 #include "adaptor_memory.h"
 
+#ifdef MEMORY_STATS
+#include <malloc.h>
+#endif
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "securec.h"
+
 #define MAX_SIZE 1073741824
+#define POOL_CLASS_NUM 3
+#define POOL_CLASS_CAPACITY 16
+#define ARENA_SIZE 16384
+#define ARENA_ALIGN 8
+// Each arena block starts after a header holding its size, so that Free can wipe it.
+#define ARENA_HEADER_SIZE ARENA_ALIGN
+
+typedef struct PoolBlock {
+    struct PoolBlock *next;
+} PoolBlock;
+
+// Sized for Buffers holding keys, signatures and tokens, header included.
+static const size_t POOL_CLASS_SIZE[POOL_CLASS_NUM] = { 64, 128, 256 };
+
+static pthread_mutex_t g_poolMutex = PTHREAD_MUTEX_INITIALIZER;
+static PoolBlock *g_poolFreeList[POOL_CLASS_NUM] = { NULL };
+static uint32_t g_poolFreeNum[POOL_CLASS_NUM] = { 0 };
+
+// Each thread has its own arena, so another thread never gets or frees memory of an open arena. The block is kept
+// between calls, only g_arenaUsed is reset, and it is released when the thread exits.
+static __thread uint8_t *g_arena = NULL;
+static __thread size_t g_arenaUsed = 0;
+static __thread uint32_t g_arenaDepth = 0;
+static pthread_key_t g_arenaKey;
+static pthread_once_t g_arenaKeyOnce = PTHREAD_ONCE_INIT;
+static bool g_arenaKeyCreated = false;
+
+#ifdef MEMORY_STATS
+// Sites beyond the table are counted in its last entry.
+static const char *OTHER_MEMORY_SITE = "others";
+static pthread_mutex_t g_statsMutex = PTHREAD_MUTEX_INITIALIZER;
+static MemoryStats g_memoryStats = { 0 };
+static MemorySiteStats g_memorySites[MAX_MEMORY_SITE_NUM] = { { NULL, 0, 0 } };
+static uint32_t g_memorySiteNum = 0;
+#endif
+
+static void RecordMemorySite(const char *site, const size_t size)
+{
+#ifdef MEMORY_STATS
+    if (site == NULL || size == 0) {
+        return;
+    }
+    (void)pthread_mutex_lock(&g_statsMutex);
+    uint32_t index = 0;
+    while (index < g_memorySiteNum && strcmp(g_memorySites[index].site, site) != 0) {
+        index++;
+    }
+    if (index == g_memorySiteNum) {
+        if (g_memorySiteNum == MAX_MEMORY_SITE_NUM) {
+            index = MAX_MEMORY_SITE_NUM - 1;
+            g_memorySites[index].site = OTHER_MEMORY_SITE;
+        } else {
+            g_memorySites[index].site = site;
+            g_memorySiteNum++;
+        }
+    }
+    g_memorySites[index].mallocCount++;
+    g_memorySites[index].mallocBytes += size;
+    (void)pthread_mutex_unlock(&g_statsMutex);
+#else
+    (void)site;
+    (void)size;
+#endif
+}
 
-void *Malloc(const size_t size)
+static void *HeapMalloc(const size_t size)
 {
     if (size == 0 || size > MAX_SIZE) {
         return NULL;
     }
-    return malloc(size);
+    void *ptr = malloc(size);
+#ifdef MEMORY_STATS
+    if (ptr != NULL) {
+        (void)pthread_mutex_lock(&g_statsMutex);
+        g_memoryStats.liveBytes += malloc_usable_size(ptr);
+        if (g_memoryStats.liveBytes > g_memoryStats.peakBytes) {
+            g_memoryStats.peakBytes = g_memoryStats.liveBytes;
+        }
+        g_memoryStats.mallocCount++;
+        (void)pthread_mutex_unlock(&g_statsMutex);
+    }
+#endif
+    return ptr;
 }
 
-void Free(void *ptr)
+static void HeapFree(void *ptr)
 {
     if (ptr == NULL) {
         return;
     }
+#ifdef MEMORY_STATS
+    (void)pthread_mutex_lock(&g_statsMutex);
+    g_memoryStats.liveBytes -= malloc_usable_size(ptr);
+    g_memoryStats.freeCount++;
+    (void)pthread_mutex_unlock(&g_statsMutex);
+#endif
     free(ptr);
-}
\ No newline at end of file
+}
+
+static bool IsArenaMemory(const void *ptr)
+{
+    return g_arena != NULL && (const uint8_t *)ptr >= g_arena && (const uint8_t *)ptr < g_arena + ARENA_SIZE;
+}
+
+void *MallocFromSite(const size_t size, const char *site)
+{
+    RecordMemorySite(site, size);
+    return HeapMalloc(size);
+}
+
+void *(Malloc)(const size_t size)
+{
+    return HeapMalloc(size);
+}
+
+static void WipeArenaBlock(void *ptr)
+{
+    uint8_t *block = (uint8_t *)ptr;
+    if (block < g_arena + ARENA_HEADER_SIZE) {
+        return;
+    }
+    size_t size = *(const size_t *)(block - ARENA_HEADER_SIZE);
+    size_t maxSize = (size_t)(g_arena + ARENA_SIZE - block);
+    if (size > maxSize) {
+        size = maxSize;
+    }
+    (void)memset_s(block, size, 0, size);
+}
+
+void Free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    if (IsArenaMemory(ptr)) {
+        WipeArenaBlock(ptr);
+        return;
+    }
+    HeapFree(ptr);
+}
+
+static int32_t GetPoolClass(const size_t size)
+{
+    for (int32_t i = 0; i < POOL_CLASS_NUM; i++) {
+        if (size <= POOL_CLASS_SIZE[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void *PoolMallocFromClass(const size_t size)
+{
+    int32_t poolClass = GetPoolClass(size);
+    if (size == 0 || poolClass < 0) {
+        return HeapMalloc(size);
+    }
+    (void)pthread_mutex_lock(&g_poolMutex);
+    PoolBlock *block = g_poolFreeList[poolClass];
+    if (block != NULL) {
+        g_poolFreeList[poolClass] = block->next;
+        g_poolFreeNum[poolClass]--;
+    }
+    (void)pthread_mutex_unlock(&g_poolMutex);
+    if (block == NULL) {
+        return HeapMalloc(POOL_CLASS_SIZE[poolClass]);
+    }
+    block->next = NULL;
+    return block;
+}
+
+void *PoolMallocFromSite(const size_t size, const char *site)
+{
+    RecordMemorySite(site, size);
+    return PoolMallocFromClass(size);
+}
+
+void *(PoolMalloc)(const size_t size)
+{
+    return PoolMallocFromClass(size);
+}
+
+void PoolFree(void *ptr, const size_t size)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    (void)memset_s(ptr, size, 0, size);
+    if (IsArenaMemory(ptr)) {
+        return;
+    }
+    int32_t poolClass = GetPoolClass(size);
+    if (poolClass < 0) {
+        Free(ptr);
+        return;
+    }
+    (void)pthread_mutex_lock(&g_poolMutex);
+    if (g_poolFreeNum[poolClass] < POOL_CLASS_CAPACITY) {
+        PoolBlock *block = (PoolBlock *)ptr;
+        block->next = g_poolFreeList[poolClass];
+        g_poolFreeList[poolClass] = block;
+        g_poolFreeNum[poolClass]++;
+        ptr = NULL;
+    }
+    (void)pthread_mutex_unlock(&g_poolMutex);
+    Free(ptr);
+}
+
+void DestroyMemoryPool(void)
+{
+    (void)pthread_mutex_lock(&g_poolMutex);
+    for (int32_t i = 0; i < POOL_CLASS_NUM; i++) {
+        while (g_poolFreeList[i] != NULL) {
+            PoolBlock *block = g_poolFreeList[i];
+            g_poolFreeList[i] = block->next;
+            HeapFree(block);
+        }
+        g_poolFreeNum[i] = 0;
+    }
+    (void)pthread_mutex_unlock(&g_poolMutex);
+    if (g_arenaDepth == 0 && g_arena != NULL) {
+        if (g_arenaKeyCreated) {
+            (void)pthread_setspecific(g_arenaKey, NULL);
+        }
+        HeapFree(g_arena);
+        g_arena = NULL;
+    }
+}
+
+static void ReleaseThreadArena(void *arena)
+{
+    HeapFree(arena);
+}
+
+static void CreateArenaKey(void)
+{
+    g_arenaKeyCreated = (pthread_key_create(&g_arenaKey, ReleaseThreadArena) == 0);
+}
+
+void BeginMemoryArena(void)
+{
+    if (g_arena == NULL) {
+        g_arena = (uint8_t *)HeapMalloc(ARENA_SIZE);
+        g_arenaUsed = 0;
+        (void)pthread_once(&g_arenaKeyOnce, CreateArenaKey);
+        if (g_arena != NULL && g_arenaKeyCreated) {
+            (void)pthread_setspecific(g_arenaKey, g_arena);
+        }
+    }
+    g_arenaDepth++;
+}
+
+void EndMemoryArena(void)
+{
+    if (g_arenaDepth == 0) {
+        return;
+    }
+    g_arenaDepth--;
+    if (g_arenaDepth == 0 && g_arena != NULL) {
+        (void)memset_s(g_arena, ARENA_SIZE, 0, g_arenaUsed);
+        g_arenaUsed = 0;
+    }
+}
+
+static void *ArenaMallocFromArena(const size_t size)
+{
+    // Fallback blocks come from the pool, so both Free and PoolFree can release them.
+    if (g_arenaDepth == 0 || g_arena == NULL || size == 0) {
+        return PoolMallocFromClass(size);
+    }
+    size_t alignedSize = (size + ARENA_ALIGN - 1) & ~((size_t)ARENA_ALIGN - 1);
+    if (alignedSize < size || alignedSize > ARENA_SIZE ||
+        ARENA_HEADER_SIZE + alignedSize > ARENA_SIZE - g_arenaUsed) {
+        return PoolMallocFromClass(size);
+    }
+    uint8_t *header = g_arena + g_arenaUsed;
+    *(size_t *)header = size;
+    g_arenaUsed += ARENA_HEADER_SIZE + alignedSize;
+    return header + ARENA_HEADER_SIZE;
+}
+
+void *ArenaMallocFromSite(const size_t size, const char *site)
+{
+    RecordMemorySite(site, size);
+    return ArenaMallocFromArena(size);
+}
+
+void *(ArenaMalloc)(const size_t size)
+{
+    return ArenaMallocFromArena(size);
+}
+
+void GetMemoryStats(MemoryStats *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+#ifdef MEMORY_STATS
+    (void)pthread_mutex_lock(&g_statsMutex);
+    *stats = g_memoryStats;
+    (void)pthread_mutex_unlock(&g_statsMutex);
+#else
+    (void)memset_s(stats, sizeof(MemoryStats), 0, sizeof(MemoryStats));
+#endif
+}
+
+uint32_t GetMemorySiteStats(MemorySiteStats *sites, uint32_t maxNum)
+{
+    if (sites == NULL) {
+        return 0;
+    }
+#ifdef MEMORY_STATS
+    (void)pthread_mutex_lock(&g_statsMutex);
+    uint32_t num = (g_memorySiteNum < maxNum) ? g_memorySiteNum : maxNum;
+    for (uint32_t i = 0; i < num; i++) {
+        sites[i] = g_memorySites[i];
+    }
+    (void)pthread_mutex_unlock(&g_statsMutex);
+    return num;
+#else
+    (void)maxNum;
+    return 0;
+#endif
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crypto_provider.h"
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+#include "adaptor_log.h"
+#include "adaptor_memory.h"
+#include "defines.h"
+
+#define OPENSSL_SUCCESS 1
+
+#define SHA256_DIGEST_SIZE 32
+
+struct Ed25519PublicKey {
+    EVP_PKEY *key;
+};
+
+struct HmacContext {
+    HMAC_CTX *keyed;
+    HMAC_CTX *work;
+};
+
+static int32_t OpensslGenerateEd25519KeyPair(KeyPair *keyPair)
+{
+    int32_t ret = RESULT_GENERAL_ERROR;
+    EVP_PKEY *key = NULL;
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, NULL);
+    if (ctx == NULL) {
+        LOG_ERROR("new ctx failed");
+        return ret;
+    }
+    if (EVP_PKEY_keygen_init(ctx) != OPENSSL_SUCCESS) {
+        LOG_ERROR("init ctx failed");
+        goto EXIT;
+    }
+    if (EVP_PKEY_keygen(ctx, &key) != OPENSSL_SUCCESS) {
+        LOG_ERROR("generate key failed");
+        goto EXIT;
+    }
+    size_t pubKeySize = keyPair->pubKey->maxSize;
+    if (EVP_PKEY_get_raw_public_key(key, keyPair->pubKey->buf, &pubKeySize) != OPENSSL_SUCCESS) {
+        LOG_ERROR("get public key failed");
+        goto EXIT;
+    }
+    keyPair->pubKey->contentSize = pubKeySize;
+    size_t priKeySize = keyPair->priKey->maxSize;
+    if (EVP_PKEY_get_raw_private_key(key, keyPair->priKey->buf, &priKeySize) != OPENSSL_SUCCESS) {
+        LOG_ERROR("get private key failed");
+        goto EXIT;
+    }
+    keyPair->priKey->contentSize = priKeySize;
+    ret = RESULT_SUCCESS;
+
+EXIT:
+    if (key != NULL) {
+        EVP_PKEY_free(key);
+    }
+    EVP_PKEY_CTX_free(ctx);
+    return ret;
+}
+
+static int32_t OpensslEd25519Sign(const KeyPair *keyPair, const Buffer *data, Buffer *sign)
+{
+    int32_t ret = RESULT_GENERAL_ERROR;
+    EVP_PKEY *key = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL,
+        keyPair->priKey->buf, keyPair->priKey->contentSize);
+    if (key == NULL) {
+        LOG_ERROR("get private key failed");
+        return ret;
+    }
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    if (ctx == NULL) {
+        LOG_ERROR("get ctx failed");
+        EVP_PKEY_free(key);
+        return ret;
+    }
+    if (EVP_DigestSignInit(ctx, NULL, NULL, NULL, key) != OPENSSL_SUCCESS) {
+        LOG_ERROR("init sign failed");
+        goto EXIT;
+    }
+    size_t signSize = sign->maxSize;
+    if (EVP_DigestSign(ctx, sign->buf, &signSize, data->buf, data->contentSize) != OPENSSL_SUCCESS) {
+        LOG_ERROR("sign failed");
+        goto EXIT;
+    }
+    sign->contentSize = signSize;
+    ret = RESULT_SUCCESS;
+
+EXIT:
+    EVP_PKEY_free(key);
+    EVP_MD_CTX_free(ctx);
+    return ret;
+}
+
+static int32_t OpensslEd25519VerifyWithPkey(EVP_PKEY *key, const Buffer *data, const Buffer *sign)
+{
+    int32_t ret = RESULT_GENERAL_ERROR;
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    if (ctx == NULL) {
+        LOG_ERROR("get ctx failed");
+        return ret;
+    }
+    if (EVP_DigestVerifyInit(ctx, NULL, NULL, NULL, key) != OPENSSL_SUCCESS) {
+        LOG_ERROR("init verify failed");
+        goto EXIT;
+    }
+    if (EVP_DigestVerify(ctx, sign->buf, sign->contentSize, data->buf, data->contentSize) != OPENSSL_SUCCESS) {
+        LOG_ERROR("verify failed");
+        goto EXIT;
+    }
+    ret = RESULT_SUCCESS;
+
+EXIT:
+    EVP_MD_CTX_free(ctx);
+    return ret;
+}
+
+static int32_t OpensslEd25519Verify(const Buffer *pubKey, const Buffer *data, const Buffer *sign)
+{
+    EVP_PKEY *key = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, NULL, pubKey->buf, pubKey->contentSize);
+    if (key == NULL) {
+        LOG_ERROR("get public key failed");
+        return RESULT_GENERAL_ERROR;
+    }
+    int32_t ret = OpensslEd25519VerifyWithPkey(key, data, sign);
+    EVP_PKEY_free(key);
+    return ret;
+}
+
+static Ed25519PublicKey *OpensslCreateEd25519PublicKey(const uint8_t *pubKey, uint32_t pubKeySize)
+{
+    Ed25519PublicKey *publicKey = Malloc(sizeof(Ed25519PublicKey));
+    if (publicKey == NULL) {
+        LOG_ERROR("no memory for public key");
+        return NULL;
+    }
+    publicKey->key = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, NULL, pubKey, pubKeySize);
+    if (publicKey->key == NULL) {
+        LOG_ERROR("get public key failed");
+        Free(publicKey);
+        return NULL;
+    }
+    return publicKey;
+}
+
+static void OpensslDestroyEd25519PublicKey(Ed25519PublicKey *publicKey)
+{
+    EVP_PKEY_free(publicKey->key);
+    Free(publicKey);
+}
+
+static int32_t OpensslEd25519VerifyWithKey(const Ed25519PublicKey *publicKey, const Buffer *data, const Buffer *sign)
+{
+    return OpensslEd25519VerifyWithPkey(publicKey->key, data, sign);
+}
+
+static int32_t OpensslHmacSha256(const Buffer *hmacKey, const Buffer *data, Buffer *hmac)
+{
+    uint32_t hmacSize = hmac->maxSize;
+    uint8_t *hmacData = HMAC(EVP_sha256(), hmacKey->buf, (int)hmacKey->contentSize, data->buf, data->contentSize,
+        hmac->buf, &hmacSize);
+    if (hmacData == NULL) {
+        LOG_ERROR("hmac failed");
+        return RESULT_GENERAL_ERROR;
+    }
+    hmac->contentSize = hmacSize;
+    return RESULT_SUCCESS;
+}
+
+static void OpensslDestroyHmacContext(HmacContext *context)
+{
+    HMAC_CTX_free(context->keyed);
+    HMAC_CTX_free(context->work);
+    Free(context);
+}
+
+static HmacContext *OpensslCreateHmacSha256Context(const Buffer *hmacKey)
+{
+    HmacContext *context = Malloc(sizeof(HmacContext));
+    if (context == NULL) {
+        LOG_ERROR("no memory for hmac context");
+        return NULL;
+    }
+    context->keyed = HMAC_CTX_new();
+    context->work = HMAC_CTX_new();
+    if (context->keyed == NULL || context->work == NULL) {
+        LOG_ERROR("new ctx failed");
+        OpensslDestroyHmacContext(context);
+        return NULL;
+    }
+    if (HMAC_Init_ex(context->keyed, hmacKey->buf, (int)hmacKey->contentSize, EVP_sha256(), NULL) != OPENSSL_SUCCESS) {
+        LOG_ERROR("init hmac failed");
+        OpensslDestroyHmacContext(context);
+        return NULL;
+    }
+    return context;
+}
+
+static int32_t OpensslHmacSha256WithContext(HmacContext *context, const uint8_t *data, uint32_t dataSize,
+    uint8_t *hmac, uint32_t hmacSize)
+{
+    // The work state keeps its digest allocations, so copying the keyed state does not allocate again.
+    if (HMAC_CTX_copy(context->work, context->keyed) != OPENSSL_SUCCESS) {
+        LOG_ERROR("copy hmac ctx failed");
+        return RESULT_GENERAL_ERROR;
+    }
+    unsigned int outSize = hmacSize;
+    if (HMAC_Update(context->work, data, dataSize) != OPENSSL_SUCCESS ||
+        HMAC_Final(context->work, hmac, &outSize) != OPENSSL_SUCCESS || outSize != SHA256_DIGEST_SIZE) {
+        LOG_ERROR("hmac failed");
+        return RESULT_GENERAL_ERROR;
+    }
+    return RESULT_SUCCESS;
+}
+
+static int32_t OpensslSecureRandom(uint8_t *buffer, uint32_t size)
+{
+    if (RAND_bytes(buffer, (int)size) != OPENSSL_SUCCESS) {
+        LOG_ERROR("rand failed");
+        return RESULT_GENERAL_ERROR;
+    }
+    return RESULT_SUCCESS;
+}
+
+CryptoProvider *GetDefaultCryptoProvider(void)
+{
+    static CryptoProvider cryptoProvider = {
+        .name = "openssl",
+        .generateEd25519KeyPair = OpensslGenerateEd25519KeyPair,
+        .ed25519Sign = OpensslEd25519Sign,
+        .ed25519Verify = OpensslEd25519Verify,
+        .createEd25519PublicKey = OpensslCreateEd25519PublicKey,
+        .destroyEd25519PublicKey = OpensslDestroyEd25519PublicKey,
+        .ed25519VerifyWithKey = OpensslEd25519VerifyWithKey,
+        .hmacSha256 = OpensslHmacSha256,
+        .createHmacSha256Context = OpensslCreateHmacSha256Context,
+        .destroyHmacContext = OpensslDestroyHmacContext,
+        .hmacSha256WithContext = OpensslHmacSha256WithContext,
+        .secureRandom = OpensslSecureRandom,
+    };
+    return &cryptoProvider;
+}
@@ -14,6 +14,7 @@
  */
 
 #include "file_operator.h"
+#include <limits.h>
 #include <stdio.h>
 #include "securec.h"
 #include "adaptor_log.h"
@@ -55,13 +56,49 @@ static int32_t ReadFile(const char *fileName, uint8_t *buf, uint32_t len)
     return RESULT_SUCCESS;
 }
 
+static int32_t ReadFileByOffset(const char *fileName, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    if ((fileName == NULL) || (buf == NULL) || (len == 0) || (len > SIZE_MAX) || (offset > LONG_MAX)) {
+        LOG_ERROR("get bad params");
+        return RESULT_BAD_PARAM;
+    }
+    FILE *fileOperator = fopen(fileName, "rb");
+    if (fileOperator == NULL) {
+        LOG_ERROR("open file failed");
+        return RESULT_BAD_PARAM;
+    }
+    if (fseek(fileOperator, (long)offset, SEEK_SET) != 0) {
+        LOG_ERROR("seek file failed");
+        (void)fclose(fileOperator);
+        return RESULT_BAD_READ;
+    }
+    size_t readLen = fread(buf, sizeof(uint8_t), len, fileOperator);
+    if (readLen != len) {
+        LOG_ERROR("read file failed");
+        (void)fclose(fileOperator);
+        (void)memset_s(buf, len, 0, len);
+        return RESULT_BAD_READ;
+    }
+    (void)fclose(fileOperator);
+    return RESULT_SUCCESS;
+}
+
+#define TEMP_FILE_SUFFIX ".tmp"
+#define MAX_FILE_NAME_LEN 256
+
+// The data is written to a temporary file and renamed over the file, so a failed write keeps the old file intact.
 static int32_t WriteFile(const char *fileName, const uint8_t *buf, uint32_t len)
 {
     if ((fileName == NULL) || (buf == NULL) || (len == 0) || (len > SIZE_MAX)) {
         LOG_ERROR("get bad params");
         return RESULT_BAD_PARAM;
     }
-    FILE *fileOperator = fopen(fileName, "wb");
+    char tempFileName[MAX_FILE_NAME_LEN];
+    if (snprintf_s(tempFileName, MAX_FILE_NAME_LEN, MAX_FILE_NAME_LEN - 1, "%s%s", fileName, TEMP_FILE_SUFFIX) < 0) {
+        LOG_ERROR("file name is too long");
+        return RESULT_BAD_PARAM;
+    }
+    FILE *fileOperator = fopen(tempFileName, "wb");
     if (fileOperator == NULL) {
         LOG_ERROR("open file failed");
         return RESULT_BAD_PARAM;
@@ -70,9 +107,19 @@ static int32_t WriteFile(const char *fileName, const uint8_t *buf, uint32_t len)
     if (writeLen != len) {
         LOG_ERROR("write file failed");
         (void)fclose(fileOperator);
+        (void)remove(tempFileName);
+        return RESULT_BAD_WRITE;
+    }
+    if (fclose(fileOperator) != 0) {
+        LOG_ERROR("close file failed");
+        (void)remove(tempFileName);
+        return RESULT_BAD_WRITE;
+    }
+    if (rename(tempFileName, fileName) != 0) {
+        LOG_ERROR("rename file failed");
+        (void)remove(tempFileName);
         return RESULT_BAD_WRITE;
     }
-    (void)fclose(fileOperator);
     return RESULT_SUCCESS;
 }
 
@@ -124,6 +171,7 @@ FileOperator *GetDefaultFileOperator(void)
         .isFileExist = IsFileExist,
         .getFileLen = GetFileLen,
         .readFile = ReadFile,
+        .readFileByOffset = ReadFileByOffset,
         .writeFile = WriteFile,
         .deleteFile = DeleteFile,
     };
@@ -26,6 +26,7 @@
 #define COAUTH_TOKEN_DATA_LEN (COAUTH_TOKEN_LEN - SHA256_SIGN_LEN)
 #define SHA256_KEY_LEN 32
 #define TOKEN_VERSION 0
+#define MAX_VERIFY_TOKEN_NUM 64
 
 typedef struct {
     uint32_t scheduleResult;
@@ -42,5 +43,8 @@ typedef struct {
 
 ResultCode CoAuthTokenSign(ScheduleTokenHal *userAuthToken);
 ResultCode CoAuthTokenVerify(const ScheduleTokenHal *userAuthToken);
+// Verifies tokenNum tokens in one pass, results[i] receives the result of tokens[i].
+// Returns RESULT_SUCCESS only if every token is valid, otherwise the first failure.
+ResultCode CoAuthTokenVerifyBatch(const ScheduleTokenHal *coAuthTokens, uint32_t tokenNum, ResultCode *results);
 
 #endif // COAUTH_SIGN_CENTRE_H
\ No newline at end of file
@@ -41,6 +41,7 @@ void DestroyResourcePool(void);
 ResultCode RegisterExecutorToPool(ExecutorInfoHal *executorInfo);
 ResultCode UnregisterExecutorToPool(uint64_t executorId);
 ResultCode QueryExecutor(uint32_t authType, LinkedList **result);
+ResultCode VerifyExecutorSign(const ExecutorInfoHal *executorInfo, const Buffer *data, const Buffer *sign);
 ExecutorInfoHal *CopyExecutorInfo(ExecutorInfoHal *src);
 
 #endif
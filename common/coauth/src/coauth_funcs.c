@@ -92,28 +92,26 @@ int32_t ScheduleFinish(const Buffer *executorMsg, ScheduleTokenHal *scheduleToke
         goto EXIT;
     }
 
-    Buffer *publicKey = NULL;
-    uint32_t index;
-    for (index = 0; index < coAuthSchedule.executorSize; index++) {
+    ExecutorInfoHal *verifier = NULL;
+    for (uint32_t index = 0; index < coAuthSchedule.executorSize; index++) {
         ExecutorInfoHal *executor = &coAuthSchedule.executors[index];
         if (executor->executorType == VERIFIER || executor->executorType == ALL_IN_ONE) {
-            publicKey = CreateBufferByData(executor->pubKey, PUBLIC_KEY_LEN);
+            verifier = executor;
             break;
         }
     }
-    if (!IsBufferValid(publicKey)) {
-        LOG_ERROR("get publicKey failed");
+    if (verifier == NULL) {
+        LOG_ERROR("get verifier failed");
+        ret = RESULT_GENERAL_ERROR;
         goto EXIT;
     }
-    ret = Ed25519Verify(publicKey, resultInfo->data, resultInfo->sign);
+    ret = VerifyExecutorSign(verifier, resultInfo->data, resultInfo->sign);
     if (ret != RESULT_SUCCESS) {
         LOG_ERROR("verify sign failed");
-        DestoryBuffer(publicKey);
         goto EXIT;
     }
 
     ret = TokenDataGetAndSign(coAuthSchedule.executors[0].authType, resultInfo, scheduleToken);
-    DestoryBuffer(publicKey);
 
 EXIT:
     DestoryExecutorResultInfo(resultInfo);
@@ -43,32 +43,12 @@ ResultCode CoAuthTokenSign(ScheduleTokenHal *coAuthToken)
         return RESULT_BAD_PARAM;
     }
     coAuthToken->version = TOKEN_VERSION;
-    ResultCode ret = RESULT_SUCCESS;
-    Buffer *data = CreateBufferByData((uint8_t *)coAuthToken, COAUTH_TOKEN_DATA_LEN);
-    Buffer *key = GetTokenKey();
-    Buffer *sign = NULL;
-    if (data == NULL || key == NULL) {
-        LOG_ERROR("lack of member");
-        ret = RESULT_NO_MEMORY;
-        goto EXIT;
-    }
-
-    if (HmacSha256(key, data, &sign) != RESULT_SUCCESS || !IsBufferValid(sign)) {
-        ret = RESULT_GENERAL_ERROR;
-        goto EXIT;
-    }
-
-    if (memcpy_s(coAuthToken->sign, SHA256_SIGN_LEN, sign->buf, sign->contentSize) != EOK) {
-        LOG_ERROR("sign copy failed");
-        ret = RESULT_BAD_COPY;
-        goto EXIT;
+    if (TokenHmacSha256((const uint8_t *)coAuthToken, COAUTH_TOKEN_DATA_LEN, coAuthToken->sign, SHA256_SIGN_LEN) !=
+        RESULT_SUCCESS) {
+        LOG_ERROR("sign token failed");
+        return RESULT_GENERAL_ERROR;
     }
-
-EXIT:
-    DestoryBuffer(data);
-    DestoryBuffer(key);
-    DestoryBuffer(sign);
-    return ret;
+    return RESULT_SUCCESS;
 }
 
 ResultCode CoAuthTokenVerify(const ScheduleTokenHal *coAuthToken)
@@ -82,31 +62,31 @@ ResultCode CoAuthTokenVerify(const ScheduleTokenHal *coAuthToken)
         LOG_ERROR("token timeout");
         return RESULT_TOKEN_TIMEOUT;
     }
-    ResultCode ret = RESULT_SUCCESS;
-    Buffer *data = CreateBufferByData((uint8_t *)coAuthToken, COAUTH_TOKEN_DATA_LEN);
-    Buffer *key = GetTokenKey();
-    Buffer *sign = CreateBufferByData(coAuthToken->sign, SHA256_SIGN_LEN);
-    Buffer *rightSign = NULL;
-    if (data == NULL || key == NULL || sign == NULL) {
-        LOG_ERROR("lack of member");
-        ret = RESULT_NO_MEMORY;
-        goto EXIT;
+    ResultCode ret = TokenHmacSha256Verify((const uint8_t *)coAuthToken, COAUTH_TOKEN_DATA_LEN, coAuthToken->sign,
+        SHA256_SIGN_LEN);
+    if (ret == RESULT_BAD_SIGN) {
+        LOG_ERROR("sign compare failed ");
+        return RESULT_BAD_SIGN;
     }
-
-    if (HmacSha256(key, data, &rightSign) != RESULT_SUCCESS || !IsBufferValid(rightSign)) {
-        ret = RESULT_GENERAL_ERROR;
-        goto EXIT;
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("verify token failed");
+        return RESULT_GENERAL_ERROR;
     }
+    return RESULT_SUCCESS;
+}
 
-    if (!CompareBuffer(rightSign, sign)) {
-        LOG_ERROR("sign compare failed ");
-        ret = RESULT_BAD_SIGN;
+ResultCode CoAuthTokenVerifyBatch(const ScheduleTokenHal *coAuthTokens, uint32_t tokenNum, ResultCode *results)
+{
+    if (coAuthTokens == NULL || results == NULL || tokenNum == 0 || tokenNum > MAX_VERIFY_TOKEN_NUM) {
+        LOG_ERROR("bad param");
+        return RESULT_BAD_PARAM;
+    }
+    ResultCode ret = RESULT_SUCCESS;
+    for (uint32_t i = 0; i < tokenNum; i++) {
+        results[i] = CoAuthTokenVerify(&coAuthTokens[i]);
+        if (results[i] != RESULT_SUCCESS && ret == RESULT_SUCCESS) {
+            ret = results[i];
+        }
     }
-
-EXIT:
-    DestoryBuffer(data);
-    DestoryBuffer(key);
-    DestoryBuffer(sign);
-    DestoryBuffer(rightSign);
     return ret;
 }
\ No newline at end of file
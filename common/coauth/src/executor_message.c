@@ -182,7 +182,7 @@ ExecutorResultInfo *GetExecutorResultInfo(const Buffer *tlv)
         return NULL;
     }
 
-    ExecutorResultInfo *result = Malloc(sizeof(ExecutorResultInfo));
+    ExecutorResultInfo *result = ArenaMalloc(sizeof(ExecutorResultInfo));
     if (result == NULL) {
         LOG_ERROR("malloc failed");
         goto EXIT;
@@ -23,6 +23,12 @@
 
 #define MAX_DUPLICATE_CHECK 100
 
+typedef struct {
+    ExecutorInfoHal info;
+    // Parsed from info.pubKey at register time, every finished schedule is verified against it.
+    Ed25519PublicKey *publicKey;
+} ExecutorPoolNode;
+
 // Resource pool list, which caches registered executor information.
 static LinkedList *g_poolList = NULL;
 
@@ -35,6 +41,17 @@ static void DestroyExecutorInfo(void *data)
     Free(data);
 }
 
+static void DestroyExecutorPoolNode(void *data)
+{
+    if (data == NULL) {
+        LOG_ERROR("data is null");
+        return;
+    }
+    ExecutorPoolNode *poolNode = (ExecutorPoolNode *)data;
+    DestroyEd25519PublicKey(poolNode->publicKey);
+    Free(poolNode);
+}
+
 static bool IsExecutorIdMatchById(void *data, void *condition)
 {
     if ((condition == NULL) || (data == NULL)) {
@@ -42,8 +59,8 @@ static bool IsExecutorIdMatchById(void *data, void *condition)
         return false;
     }
     uint64_t executorId = *(uint64_t *)condition;
-    ExecutorInfoHal *executorInfo = (ExecutorInfoHal *)data;
-    return (executorInfo->executorId == executorId);
+    ExecutorPoolNode *poolNode = (ExecutorPoolNode *)data;
+    return (poolNode->info.executorId == executorId);
 }
 
 static bool IsExecutorIdMatchByType(void *data, void *condition)
@@ -53,7 +70,7 @@ static bool IsExecutorIdMatchByType(void *data, void *condition)
         return false;
     }
     ExecutorInfoHal *executorIndex = (ExecutorInfoHal *)condition;
-    ExecutorInfoHal *executorInfo = (ExecutorInfoHal *)data;
+    ExecutorInfoHal *executorInfo = &((ExecutorPoolNode *)data)->info;
     return (executorInfo->executorType == executorIndex->executorType &&
         executorInfo->authType == executorIndex->authType);
 }
@@ -66,7 +83,7 @@ static bool IsInit()
 ResultCode InitResourcePool(void)
 {
     if (!IsInit()) {
-        g_poolList = CreateLinkedList(DestroyExecutorInfo);
+        g_poolList = CreateLinkedList(DestroyExecutorPoolNode);
     }
     if (g_poolList == NULL) {
         return RESULT_GENERAL_ERROR;
@@ -92,10 +109,10 @@ static bool IsExecutorValid(ExecutorInfoHal *executorInfo)
 static bool IsExecutorIdDuplicate(uint64_t executorId)
 {
     LinkedListNode *temp = g_poolList->head;
-    ExecutorInfoHal *executorInfo = NULL;
+    ExecutorPoolNode *poolNode = NULL;
     while (temp != NULL) {
-        executorInfo = (ExecutorInfoHal *)temp->data;
-        if (executorInfo != NULL && executorInfo->executorId == executorId) {
+        poolNode = (ExecutorPoolNode *)temp->data;
+        if (poolNode != NULL && poolNode->info.executorId == executorId) {
             return true;
         }
         temp = temp->next;
@@ -145,15 +162,22 @@ ResultCode RegisterExecutorToPool(ExecutorInfoHal *executorInfo)
         LOG_ERROR("get executorId failed");
         return result;
     }
-    ExecutorInfoHal *executorCopy = CopyExecutorInfo(executorInfo);
-    if (executorCopy == NULL) {
-        LOG_ERROR("copy executor failed");
+    ExecutorPoolNode *poolNode = (ExecutorPoolNode *)Malloc(sizeof(ExecutorPoolNode));
+    if (poolNode == NULL) {
+        LOG_ERROR("no memory");
         return RESULT_NO_MEMORY;
     }
-    result = g_poolList->insert(g_poolList, (void *)executorCopy);
+    poolNode->info = *executorInfo;
+    poolNode->publicKey = CreateEd25519PublicKey(executorInfo->pubKey, PUBLIC_KEY_LEN);
+    if (poolNode->publicKey == NULL) {
+        LOG_ERROR("parse public key failed");
+        Free(poolNode);
+        return RESULT_BAD_PARAM;
+    }
+    result = g_poolList->insert(g_poolList, (void *)poolNode);
     if (result != RESULT_SUCCESS) {
         LOG_ERROR("insert failed");
-        DestroyExecutorInfo(executorCopy);
+        DestroyExecutorPoolNode(poolNode);
         return result;
     }
     return result;
@@ -168,6 +192,42 @@ ResultCode UnregisterExecutorToPool(uint64_t executorId)
     return g_poolList->remove(g_poolList, (void *)&executorId, IsExecutorIdMatchById, true);
 }
 
+static ResultCode VerifyWithSnapshotKey(const ExecutorInfoHal *executorInfo, const Buffer *data, const Buffer *sign)
+{
+    BUFFER_INLINE(publicKey, PUBLIC_KEY_LEN);
+    if (memcpy_s(publicKey.buf, publicKey.maxSize, executorInfo->pubKey, PUBLIC_KEY_LEN) != EOK) {
+        LOG_ERROR("copy publicKey failed");
+        return RESULT_BAD_COPY;
+    }
+    publicKey.contentSize = PUBLIC_KEY_LEN;
+    return Ed25519Verify(&publicKey, data, sign);
+}
+
+// The cached key is used while the executor is registered with the key of the snapshot, else the snapshot key is
+// imported once, so that a schedule still finishes after its executor was unregistered or registered again.
+ResultCode VerifyExecutorSign(const ExecutorInfoHal *executorInfo, const Buffer *data, const Buffer *sign)
+{
+    if (executorInfo == NULL) {
+        LOG_ERROR("executorInfo is null");
+        return RESULT_BAD_PARAM;
+    }
+    if (!IsInit()) {
+        LOG_ERROR("pool not init");
+        return RESULT_NEED_INIT;
+    }
+    LinkedListNode *temp = g_poolList->head;
+    while (temp != NULL) {
+        ExecutorPoolNode *poolNode = (ExecutorPoolNode *)temp->data;
+        if (poolNode != NULL && poolNode->info.executorId == executorInfo->executorId &&
+            memcmp(poolNode->info.pubKey, executorInfo->pubKey, PUBLIC_KEY_LEN) == 0) {
+            return Ed25519VerifyWithKey(poolNode->publicKey, data, sign);
+        }
+        temp = temp->next;
+    }
+    LOG_INFO("executor is not registered with this key, verify with the schedule copy");
+    return VerifyWithSnapshotKey(executorInfo, data, sign);
+}
+
 ExecutorInfoHal *CopyExecutorInfo(ExecutorInfoHal *src)
 {
     if (src == NULL) {
@@ -210,7 +270,12 @@ ResultCode QueryExecutor(uint32_t authType, LinkedList **result)
     }
 
     while (iterator->hasNext(iterator)) {
-        ExecutorInfoHal *executorInfo = (ExecutorInfoHal *)iterator->next(iterator);
+        ExecutorPoolNode *poolNode = (ExecutorPoolNode *)iterator->next(iterator);
+        if (poolNode == NULL) {
+            LOG_ERROR("get invalid executor info");
+            continue;
+        }
+        ExecutorInfoHal *executorInfo = &poolNode->info;
         if (!IsExecutorValid(executorInfo)) {
             LOG_ERROR("get invalid executor info");
             continue;
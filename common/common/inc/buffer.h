@@ -32,7 +32,17 @@ void DestoryBuffer(Buffer *buffer);
 Buffer *CopyBuffer(const Buffer *buffer);
 bool CompareBuffer(const Buffer *buffer1, const Buffer *buffer2);
 Buffer *CreateBufferByData(const uint8_t *data, const uint32_t dataSize);
+// Same as CreateBufferByData, but from the call's scratch arena when one is open.
+Buffer *CreateArenaBufferByData(const uint8_t *data, const uint32_t dataSize);
 ResultCode GetBufferData(const Buffer *buffer, uint8_t *data, uint32_t *dataSize);
 bool CheckBufferWithSize(const Buffer *buffer, const uint32_t size);
+void WipeInlineBuffer(Buffer *buffer);
+
+// Declares an empty Buffer backed by stack storage for fixed-size values used within one function.
+// The storage is wiped when the Buffer goes out of scope, it must never be passed to DestoryBuffer.
+// Declare it before any goto that jumps past it.
+#define BUFFER_INLINE(name, size) \
+    uint8_t name##Storage[(size)]; \
+    Buffer name __attribute__((cleanup(WipeInlineBuffer))) = { name##Storage, 0, (size) }
 
 #endif
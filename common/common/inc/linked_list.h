@@ -41,6 +41,7 @@ typedef struct LinkedList {
     uint32_t (*getSize)(struct LinkedList *list);
     ResultCode (*insert)(struct LinkedList *list, void *data);
     ResultCode (*remove)(struct LinkedList *list, void *condition, MatchFunc matchFunc, bool destroyNode);
+    ResultCode (*moveToHead)(struct LinkedList *list, void *condition, MatchFunc matchFunc);
     LinkedListIterator *(*createIterator)(struct LinkedList *list);
     void (*destroyIterator)(LinkedListIterator *iterator);
 } LinkedList;
@@ -17,6 +17,7 @@
 
 #include "securec.h"
 
+#include "adaptor_algorithm.h"
 #include "adaptor_log.h"
 #include "adaptor_memory.h"
 
@@ -49,22 +50,16 @@ Buffer *CreateBuffer(const uint32_t size)
         return NULL;
     }
 
-    Buffer *buffer = (Buffer *)Malloc(sizeof(Buffer));
+    // Header and payload share one pooled block.
+    Buffer *buffer = (Buffer *)PoolMalloc(sizeof(Buffer) + size);
     if (buffer == NULL) {
-        LOG_ERROR("malloc buffer struct failed");
-        return NULL;
-    }
-
-    buffer->buf = (uint8_t *)Malloc(size);
-    if (buffer->buf == NULL) {
-        LOG_ERROR("malloc buffer data failed");
-        Free(buffer);
+        LOG_ERROR("malloc buffer failed");
         return NULL;
     }
+    buffer->buf = (uint8_t *)(buffer + 1);
 
     if (memset_s(buffer->buf, size, 0, size) != EOK) {
-        Free(buffer->buf);
-        Free(buffer);
+        PoolFree(buffer, sizeof(Buffer) + size);
         return NULL;
     }
     buffer->maxSize = size;
@@ -73,6 +68,23 @@ Buffer *CreateBuffer(const uint32_t size)
     return buffer;
 }
 
+static Buffer *InitBufferByData(void *block, const uint8_t *data, const uint32_t dataSize)
+{
+    Buffer *buffer = (Buffer *)block;
+    buffer->buf = (uint8_t *)(buffer + 1);
+    buffer->maxSize = dataSize;
+    buffer->contentSize = 0;
+
+    if (memcpy_s(buffer->buf, dataSize, data, dataSize) != EOK) {
+        LOG_ERROR("copy buffer failed");
+        DestoryBuffer(buffer);
+        return NULL;
+    }
+    buffer->contentSize = dataSize;
+
+    return buffer;
+}
+
 Buffer *CreateBufferByData(const uint8_t *data, const uint32_t dataSize)
 {
     if ((data == NULL) || (dataSize == 0) || (dataSize > MAX_BUFFER_SIZE)) {
@@ -80,43 +92,34 @@ Buffer *CreateBufferByData(const uint8_t *data, const uint32_t dataSize)
         return NULL;
     }
 
-    Buffer *buffer = (Buffer *)Malloc(sizeof(Buffer));
-    if (buffer == NULL) {
-        LOG_ERROR("malloc buffer struct failed");
+    void *block = PoolMalloc(sizeof(Buffer) + dataSize);
+    if (block == NULL) {
+        LOG_ERROR("malloc buffer failed");
         return NULL;
     }
+    return InitBufferByData(block, data, dataSize);
+}
 
-    buffer->buf = (uint8_t *)Malloc(dataSize);
-    if (buffer->buf == NULL) {
-        LOG_ERROR("malloc buffer data failed");
-        Free(buffer);
+Buffer *CreateArenaBufferByData(const uint8_t *data, const uint32_t dataSize)
+{
+    if ((data == NULL) || (dataSize == 0) || (dataSize > MAX_BUFFER_SIZE)) {
+        LOG_ERROR("invalid param, dataSize: %u", dataSize);
         return NULL;
     }
 
-    if (memcpy_s(buffer->buf, dataSize, data, dataSize) != EOK) {
-        LOG_ERROR("copy buffer failed");
-        DestoryBuffer(buffer);
+    // Outside an arena this is a heap block, which PoolFree also releases.
+    void *block = ArenaMalloc(sizeof(Buffer) + dataSize);
+    if (block == NULL) {
+        LOG_ERROR("malloc buffer failed");
         return NULL;
     }
-    buffer->maxSize = dataSize;
-    buffer->contentSize = dataSize;
-
-    return buffer;
+    return InitBufferByData(block, data, dataSize);
 }
 
 void DestoryBuffer(Buffer *buffer)
 {
     if (buffer != NULL) {
-        if (buffer->buf != NULL) {
-            if (memset_s(buffer->buf, buffer->maxSize, 0, buffer->maxSize) != EOK) {
-                LOG_ERROR("meset failed");
-            }
-            Free(buffer->buf);
-            buffer->buf = NULL;
-            buffer->contentSize = 0;
-            buffer->maxSize = 0;
-        }
-        Free(buffer);
+        PoolFree(buffer, sizeof(Buffer) + buffer->maxSize);
     }
 }
 
@@ -152,11 +155,7 @@ bool CompareBuffer(const Buffer *buffer1, const Buffer *buffer2)
         return false;
     }
 
-    if (memcmp(buffer1->buf, buffer2->buf, buffer1->contentSize) == 0) {
-        return true;
-    }
-
-    return false;
+    return SecureCompare(buffer1->buf, buffer2->buf, buffer1->contentSize);
 }
 
 ResultCode GetBufferData(const Buffer *buffer, uint8_t *data, uint32_t *dataSize)
@@ -171,4 +170,13 @@ ResultCode GetBufferData(const Buffer *buffer, uint8_t *data, uint32_t *dataSize
     }
     *dataSize = buffer->contentSize;
     return RESULT_SUCCESS;
+}
+
+void WipeInlineBuffer(Buffer *buffer)
+{
+    if (buffer == NULL || buffer->buf == NULL) {
+        return;
+    }
+    (void)memset_s(buffer->buf, buffer->maxSize, 0, buffer->maxSize);
+    buffer->contentSize = 0;
 }
\ No newline at end of file
@@ -80,6 +80,36 @@ static ResultCode RemoveNode(LinkedList *list, void *condition, MatchFunc matchF
     return RESULT_SUCCESS;
 }
 
+static ResultCode MoveNodeToHead(LinkedList *list, void *condition, MatchFunc matchFunc)
+{
+    if (list == NULL) {
+        LOG_ERROR("list is null");
+        return RESULT_BAD_PARAM;
+    }
+    if (matchFunc == NULL) {
+        LOG_ERROR("matchFunc is null");
+        return RESULT_BAD_PARAM;
+    }
+    LinkedListNode *pre = NULL;
+    LinkedListNode *node = list->head;
+    while (node != NULL) {
+        if (matchFunc(node->data, condition)) {
+            break;
+        }
+        pre = node;
+        node = node->next;
+    }
+    if (node == NULL) {
+        return RESULT_NOT_FOUND;
+    }
+    if (pre != NULL) {
+        pre->next = node->next;
+        node->next = list->head;
+        list->head = node;
+    }
+    return RESULT_SUCCESS;
+}
+
 static uint32_t GetSize(LinkedList *list)
 {
     if (list == NULL) {
@@ -152,6 +182,7 @@ LinkedList *CreateLinkedList(DestroyDataFunc destroyDataFunc)
     list->getSize = GetSize;
     list->insert = InsertNode;
     list->remove = RemoveNode;
+    list->moveToHead = MoveNodeToHead;
     list->createIterator = CreateIterator;
     list->destroyIterator = DestroyIterator;
     return list;
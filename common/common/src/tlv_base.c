@@ -44,7 +44,7 @@ uint64_t Ntohll(uint64_t data)
 
 TlvListNode *CreateTlvList(void)
 {
-    TlvListNode *node = (TlvListNode *)Malloc(sizeof(TlvListNode));
+    TlvListNode *node = (TlvListNode *)ArenaMalloc(sizeof(TlvListNode));
     if (node == NULL) {
         return NULL;
     }
@@ -58,14 +58,14 @@ TlvType *CreateTlvType(int32_t type, uint32_t length, const void *value)
     if (value == NULL || length == 0) {
         return NULL;
     }
-    TlvType *tlv = (TlvType *)Malloc(sizeof(TlvType));
+    TlvType *tlv = (TlvType *)ArenaMalloc(sizeof(TlvType));
     if (tlv == NULL) {
         return NULL;
     }
 
     tlv->type = type;
     tlv->length = length;
-    tlv->value = (uint8_t *)Malloc(length);
+    tlv->value = (uint8_t *)ArenaMalloc(length);
     if (tlv->value == NULL) {
         Free(tlv);
         return NULL;
@@ -110,7 +110,7 @@ int32_t AddTlvNode(TlvListNode *head, const TlvObject *object)
         return PARAM_ERR;
     }
 
-    TlvListNode *node = (TlvListNode *)Malloc(sizeof(TlvListNode));
+    TlvListNode *node = (TlvListNode *)ArenaMalloc(sizeof(TlvListNode));
     if (node == NULL) {
         return MALLOC_FAIL;
     }
@@ -28,7 +28,7 @@ static int32_t PutTlvObject(TlvListNode *head, int32_t type, uint32_t length, co
         return PARAM_ERR;
     }
 
-    TlvType *tlv = (TlvType *)Malloc(sizeof(TlvType));
+    TlvType *tlv = (TlvType *)ArenaMalloc(sizeof(TlvType));
     if (tlv == NULL) {
         return MALLOC_FAIL;
     }
@@ -37,7 +37,7 @@ static int32_t PutTlvObject(TlvListNode *head, int32_t type, uint32_t length, co
     tlv->length = length;
     tlv->value = NULL;
     if (length > 0) {
-        tlv->value = (uint8_t *)Malloc(length);
+        tlv->value = (uint8_t *)ArenaMalloc(length);
         if (tlv->value == NULL) {
             Free(tlv);
             tlv = NULL;
@@ -207,9 +207,9 @@ Buffer *ParseBuffPara(TlvListNode *node, int32_t msgType)
         LOG_ERROR("ParseBuffPara GetTlvValue failed");
         return NULL;
     }
-    Buffer *buff = CreateBufferByData(val, len);
+    Buffer *buff = CreateArenaBufferByData(val, len);
     if (buff == NULL) {
-        LOG_ERROR("ParseBuffPara CreateBufferByData failed");
+        LOG_ERROR("ParseBuffPara CreateArenaBufferByData failed");
         return NULL;
     }
     return buff;
@@ -22,10 +22,21 @@
 #include "adaptor_memory.h"
 #include "idm_common.h"
 
+// Called for each matched credential, the credential must not be cached by the visitor.
+typedef ResultCode (*CredentialVisitFunc)(const CredentialInfoHal *credentialInfo, void *visitorContext);
+
 ResultCode InitUserInfoList(void);
 void DestroyUserInfoList(void);
 UserInfo *InitUserInfoNode(void);
 
+// Add, delete and user deletion between begin and commit change copies of the users, which the commit validates,
+// applies and writes to the file once. A failed commit rolls back, and a rollback drops the copies.
+ResultCode BeginUserInfoTransaction(void);
+ResultCode CommitUserInfoTransaction(void);
+ResultCode RollbackUserInfoTransaction(void);
+// Writes the pending changes of the persist worker now.
+ResultCode FlushUserInfo(void);
+
 ResultCode GetSecureUid(int32_t userId, uint64_t *secUid);
 ResultCode GetEnrolledInfo(int32_t userId, EnrolledInfoHal **enrolledInfos, uint32_t *num);
 ResultCode GetEnrolledInfoAuthType(int32_t userId, uint32_t authType, EnrolledInfoHal *enrolledInfo);
@@ -36,5 +47,7 @@ ResultCode QueryCredentialInfoAll(int32_t userId, CredentialInfoHal **credential
 ResultCode QueryCredentialInfo(int32_t userId, uint32_t authType, CredentialInfoHal *credentialInfo);
 ResultCode DeleteCredentialInfo(int32_t userId, uint64_t credentialId, CredentialInfoHal *credentialInfo);
 ResultCode QueryCredentialFromExecutor(uint32_t authType, CredentialInfoHal **credentialInfos, uint32_t *num);
+ResultCode VisitCredentialInfoAll(int32_t userId, CredentialVisitFunc visitor, void *visitorContext);
+ResultCode VisitCredentialFromExecutor(uint32_t authType, CredentialVisitFunc visitor, void *visitorContext);
 
 #endif // IDM_DATABASE_H
\ No newline at end of file
@@ -18,11 +18,36 @@
 
 #include "stdint.h"
 
+#include "buffer.h"
 #include "defines.h"
+#include "idm_common.h"
 #include "linked_list.h"
 
+typedef struct {
+    int32_t userId;
+    uint64_t secUid;
+    uint32_t offset;
+    uint32_t length;
+    bool resident;
+    // Set when the resident user is changed after its record was written, such a user is never evicted.
+    bool dirty;
+} UserInfoRecord;
+
+// Locates each user record in the user file, so that users are read from the file on demand.
+typedef struct {
+    UserInfoRecord *records;
+    uint32_t recordNum;
+} UserInfoIndex;
+
+typedef ResultCode (*UserInfoVisitFunc)(UserInfo *userInfo, void *visitorContext);
+
 LinkedList *LoadFileInfo(void);
 ResultCode UpdateFileInfo(LinkedList *userInfoList);
+UserInfoIndex *LoadFileIndex(void);
+void DestroyUserInfoIndex(UserInfoIndex *userIndex);
+UserInfo *LoadUserInfoFromIndex(UserInfoIndex *userIndex, uint32_t recordIndex);
+ResultCode VisitUserInfoFromIndex(UserInfoIndex *userIndex, UserInfoVisitFunc visitor, void *visitorContext);
+ResultCode UpdateFileInfoWithIndex(LinkedList *userInfoList, UserInfoIndex *userIndex);
 ResultCode DeleteFile();
 
 #endif // IDM_FILE_MANAGER_H
\ No newline at end of file
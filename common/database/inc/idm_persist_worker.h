@@ -0,0 +1,29 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IDM_PERSIST_WORKER_H
+#define IDM_PERSIST_WORKER_H
+
+#include "defines.h"
+
+// Runs under the global lock on the worker thread.
+typedef void (*PersistTask)(void);
+
+ResultCode StartPersistWorker(PersistTask task);
+// Joins the worker, pending changes are left to the caller. It may be called with the global lock held.
+void StopPersistWorker(void);
+void NotifyPersistWorker(void);
+
+#endif // IDM_PERSIST_WORKER_H
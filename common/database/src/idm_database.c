@@ -20,21 +20,67 @@
 #include "adaptor_algorithm.h"
 #include "adaptor_log.h"
 #include "idm_file_manager.h"
+#include "idm_persist_worker.h"
 
 #define MAX_DUPLICATE_CHECK 100
 #define PRE_APPLY_NUM 5
 #define MEM_GROWTH_FACTOR 2
 #define MAX_CREDENTIAL_RETURN 5000
+#define MAX_RESIDENT_USER 8
 
-// Caches IDM user information.
+// Caches IDM user information, only the recently used users are resident when g_userIndex is loaded.
 static LinkedList *g_userInfoList = NULL;
 
+// Indexes all persisted users for lazy loading, it is NULL when all users are resident.
+static UserInfoIndex *g_userIndex = NULL;
+
 // Caches the current user to reduce the number of user list traversal times.
 static UserInfo *g_currentUser = NULL;
 
+// Mutations in an open transaction are made on copies of the users in g_stagedUserList. The commit validates the
+// copies, swaps them into g_userInfoList and writes the file once, a rollback drops the copies.
+static bool g_inTransaction = false;
+static bool g_transactionDirty = false;
+static LinkedList *g_stagedUserList = NULL;
+
+// Set when the persist worker runs, mutations then mark the file dirty and the worker writes it later.
+// A failed write also marks the file dirty, so that the next flush writes it again.
+static bool g_asyncPersist = false;
+static bool g_persistDirty = false;
+
 typedef bool (*DuplicateCheckFunc)(LinkedList *collection, uint64_t value);
 
+typedef struct {
+    uint32_t authType;
+    uint32_t num;
+    CredentialVisitFunc visitor;
+    void *visitorContext;
+} ExecutorVisitContext;
+
+typedef struct {
+    CredentialInfoHal *credentialInfos;
+    uint32_t num;
+    uint32_t capacity;
+} CredentialArray;
+
+// A user changed in the open transaction. user is NULL when the user is deleted, and holds the replaced user of
+// g_userInfoList while the commit writes the file.
+typedef struct {
+    int32_t userId;
+    UserInfo *user;
+    // The user was in g_userInfoList when the transaction began.
+    bool existed;
+    // The dirty flag of the record of the user, the record is kept dirty so that the user is never evicted.
+    bool recordDirty;
+} StagedUserInfo;
+
 static UserInfo *QueryUserInfo(int32_t userId);
+static UserInfoRecord *QueryResidentRecord(int32_t userId);
+static void EvictUserInfo(uint32_t residentNum);
+static bool MatchUserInfo(void *data, void *condition);
+static bool IsUserInfoValid(UserInfo *userInfo);
+static uint32_t GetUserNum(void);
+static void PersistUserInfoTask(void);
 static ResultCode GetAllEnrolledInfoFromUser(UserInfo *userInfo, EnrolledInfoHal **enrolledInfos, uint32_t *num);
 static ResultCode GetAllCredentialInfoFromUser(UserInfo *userInfo, CredentialInfoHal **credentialInfos, uint32_t *num);
 static ResultCode DeleteUser(int32_t userId);
@@ -43,25 +89,441 @@ static CredentialInfoHal *QueryCredentialByAuthType(uint32_t authType, LinkedLis
 static bool MatchCredentialById(void *data, void *condition);
 static ResultCode GenerateDeduplicateUint64(LinkedList *collection, uint64_t *destValue, DuplicateCheckFunc func);
 
+static ResultCode LoadUserInfo(LinkedList **userInfoList, UserInfoIndex **userIndex)
+{
+    *userIndex = NULL;
+#ifdef IDM_LAZY_LOAD
+    *userIndex = LoadFileIndex();
+    if (*userIndex == NULL) {
+        LOG_ERROR("load file index failed");
+        return RESULT_NEED_INIT;
+    }
+    *userInfoList = CreateLinkedList(DestroyUserInfoNode);
+    if (*userInfoList == NULL) {
+        LOG_ERROR("create userInfoList failed");
+        DestroyUserInfoIndex(*userIndex);
+        *userIndex = NULL;
+        return RESULT_NO_MEMORY;
+    }
+#else
+    *userInfoList = LoadFileInfo();
+    if (*userInfoList == NULL) {
+        LOG_ERROR("load file info failed");
+        return RESULT_NEED_INIT;
+    }
+#endif
+    return RESULT_SUCCESS;
+}
+
 ResultCode InitUserInfoList(void)
 {
     if (g_userInfoList != NULL) {
         DestroyUserInfoList();
         g_userInfoList = NULL;
     }
-    g_userInfoList = LoadFileInfo();
-    if (g_userInfoList == NULL) {
-        LOG_ERROR("load file info failed");
-        return RESULT_NEED_INIT;
+    g_currentUser = NULL;
+    ResultCode ret = LoadUserInfo(&g_userInfoList, &g_userIndex);
+    if (ret != RESULT_SUCCESS) {
+        return ret;
     }
+#ifdef IDM_ASYNC_PERSIST
+    g_asyncPersist = (StartPersistWorker(PersistUserInfoTask) == RESULT_SUCCESS);
+#endif
     LOG_INFO("InitUserInfoList done");
     return RESULT_SUCCESS;
 }
 
 void DestroyUserInfoList(void)
 {
+    if (g_inTransaction) {
+        (void)RollbackUserInfoTransaction();
+    }
+    // The worker is joined first, the pending changes are then written here.
+    StopPersistWorker();
+    g_asyncPersist = false;
+    if (FlushUserInfo() != RESULT_SUCCESS) {
+        LOG_ERROR("flush user info failed");
+    }
+    g_persistDirty = false;
     DestroyLinkedList(g_userInfoList);
     g_userInfoList = NULL;
+    DestroyUserInfoIndex(g_userIndex);
+    g_userIndex = NULL;
+    g_currentUser = NULL;
+}
+
+static ResultCode WriteUserInfoFile(void)
+{
+    ResultCode ret;
+    if (g_userIndex != NULL) {
+        ret = UpdateFileInfoWithIndex(g_userInfoList, g_userIndex);
+    } else {
+        ret = UpdateFileInfo(g_userInfoList);
+    }
+    // A failed write is retried by the next flush, the changed users stay dirty and resident until it succeeds.
+    g_persistDirty = (ret != RESULT_SUCCESS);
+    // Users added or changed since the last write were kept resident, they can be evicted now.
+    if (ret == RESULT_SUCCESS && g_userIndex != NULL) {
+        EvictUserInfo(MAX_RESIDENT_USER);
+    }
+    return ret;
+}
+
+static ResultCode UpdateUserInfoFile(int32_t userId)
+{
+    if (g_userIndex != NULL) {
+        UserInfoRecord *record = QueryResidentRecord(userId);
+        if (record != NULL) {
+            record->dirty = true;
+        }
+    }
+    if (g_inTransaction) {
+        g_transactionDirty = true;
+        return RESULT_SUCCESS;
+    }
+    if (g_asyncPersist) {
+        g_persistDirty = true;
+        NotifyPersistWorker();
+        return RESULT_SUCCESS;
+    }
+    return WriteUserInfoFile();
+}
+
+ResultCode FlushUserInfo(void)
+{
+    // The changes of an open transaction are written by its commit only.
+    if (!g_persistDirty || g_userInfoList == NULL || g_inTransaction) {
+        return RESULT_SUCCESS;
+    }
+    ResultCode ret = WriteUserInfoFile();
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("write user info failed");
+        return ret;
+    }
+    return RESULT_SUCCESS;
+}
+
+static void PersistUserInfoTask(void)
+{
+    if (FlushUserInfo() != RESULT_SUCCESS) {
+        LOG_ERROR("persist user info failed, retry on next change");
+    }
+}
+
+static void DestroyStagedUserInfo(void *data)
+{
+    if (data == NULL) {
+        return;
+    }
+    StagedUserInfo *staged = (StagedUserInfo *)data;
+    if (staged->user != NULL) {
+        DestroyUserInfoNode(staged->user);
+    }
+    Free(staged);
+}
+
+static StagedUserInfo *QueryStagedUser(int32_t userId)
+{
+    LinkedListNode *temp = g_stagedUserList->head;
+    while (temp != NULL) {
+        StagedUserInfo *staged = (StagedUserInfo *)temp->data;
+        if (staged != NULL && staged->userId == userId) {
+            return staged;
+        }
+        temp = temp->next;
+    }
+    return NULL;
+}
+
+static StagedUserInfo *StageUserInfo(int32_t userId, UserInfo *user, bool existed)
+{
+    StagedUserInfo *staged = Malloc(sizeof(StagedUserInfo));
+    if (staged == NULL) {
+        LOG_ERROR("staged malloc failed");
+        return NULL;
+    }
+    staged->userId = userId;
+    staged->user = user;
+    staged->existed = existed;
+    staged->recordDirty = false;
+    UserInfoRecord *record = (g_userIndex != NULL) ? QueryResidentRecord(userId) : NULL;
+    if (record != NULL) {
+        staged->recordDirty = record->dirty;
+        record->dirty = true;
+    }
+    if (g_stagedUserList->insert(g_stagedUserList, staged) != RESULT_SUCCESS) {
+        LOG_ERROR("insert staged user failed");
+        if (record != NULL) {
+            record->dirty = staged->recordDirty;
+        }
+        Free(staged);
+        return NULL;
+    }
+    return staged;
+}
+
+static ResultCode CopyInfoList(LinkedList *from, LinkedList *to, uint32_t infoSize)
+{
+    uint32_t size = from->getSize(from);
+    if (size > MAX_CREDENTIAL) {
+        LOG_ERROR("bad info num");
+        return RESULT_BAD_PARAM;
+    }
+    // The list inserts at its head, the infos are copied from the tail to keep their order.
+    void *infos[MAX_CREDENTIAL];
+    LinkedListNode *temp = from->head;
+    for (uint32_t i = 0; i < size; i++) {
+        if (temp == NULL || temp->data == NULL) {
+            LOG_ERROR("listSize is invalid");
+            return RESULT_BAD_PARAM;
+        }
+        infos[i] = temp->data;
+        temp = temp->next;
+    }
+    for (uint32_t i = size; i > 0; i--) {
+        void *info = Malloc(infoSize);
+        if (info == NULL) {
+            LOG_ERROR("info malloc failed");
+            return RESULT_NO_MEMORY;
+        }
+        if (memcpy_s(info, infoSize, infos[i - 1], infoSize) != EOK ||
+            to->insert(to, info) != RESULT_SUCCESS) {
+            LOG_ERROR("copy info failed");
+            Free(info);
+            return RESULT_BAD_COPY;
+        }
+    }
+    return RESULT_SUCCESS;
+}
+
+static UserInfo *CopyUserInfo(const UserInfo *user)
+{
+    UserInfo *copy = InitUserInfoNode();
+    if (copy == NULL) {
+        LOG_ERROR("userInfoNode init failed");
+        return NULL;
+    }
+    copy->userId = user->userId;
+    copy->secUid = user->secUid;
+    if (CopyInfoList(user->credentialInfoList, copy->credentialInfoList, sizeof(CredentialInfoHal)) != RESULT_SUCCESS ||
+        CopyInfoList(user->enrolledInfoList, copy->enrolledInfoList, sizeof(EnrolledInfoHal)) != RESULT_SUCCESS) {
+        LOG_ERROR("copy user failed");
+        DestroyUserInfoNode(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+// Returns the user to change, in an open transaction that is a copy which the commit applies.
+static UserInfo *QueryUserInfoForUpdate(int32_t userId)
+{
+    if (!g_inTransaction) {
+        return QueryUserInfo(userId);
+    }
+    StagedUserInfo *staged = QueryStagedUser(userId);
+    if (staged != NULL) {
+        return staged->user;
+    }
+    UserInfo *user = QueryUserInfo(userId);
+    if (user == NULL) {
+        return NULL;
+    }
+    UserInfo *copy = CopyUserInfo(user);
+    if (copy == NULL) {
+        return NULL;
+    }
+    if (StageUserInfo(userId, copy, true) == NULL) {
+        DestroyUserInfoNode(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+static ResultCode InsertUserInfo(UserInfo *user)
+{
+    if (!g_inTransaction) {
+        return g_userInfoList->insert(g_userInfoList, user);
+    }
+    StagedUserInfo *staged = QueryStagedUser(user->userId);
+    if (staged != NULL) {
+        if (staged->user != NULL) {
+            LOG_ERROR("user is already staged");
+            return RESULT_BAD_PARAM;
+        }
+        staged->user = user;
+        return RESULT_SUCCESS;
+    }
+    return (StageUserInfo(user->userId, user, false) != NULL) ? RESULT_SUCCESS : RESULT_NO_MEMORY;
+}
+
+// Drops the copies, the records get back the dirty flags they had before the transaction.
+static void DiscardStagedUserInfo(void)
+{
+    LinkedListNode *temp = g_stagedUserList->head;
+    while (temp != NULL && g_userIndex != NULL) {
+        StagedUserInfo *staged = (StagedUserInfo *)temp->data;
+        UserInfoRecord *record = (staged != NULL) ? QueryResidentRecord(staged->userId) : NULL;
+        if (record != NULL) {
+            record->dirty = staged->recordDirty;
+        }
+        temp = temp->next;
+    }
+    DestroyLinkedList(g_stagedUserList);
+    g_stagedUserList = NULL;
+}
+
+static ResultCode CheckStagedUserInfo(void)
+{
+    LinkedListNode *temp = g_stagedUserList->head;
+    while (temp != NULL) {
+        StagedUserInfo *staged = (StagedUserInfo *)temp->data;
+        if (staged == NULL) {
+            LOG_ERROR("staged user is null");
+            return RESULT_BAD_PARAM;
+        }
+        if (staged->user != NULL && (!IsUserInfoValid(staged->user) ||
+            staged->user->credentialInfoList->getSize(staged->user->credentialInfoList) > MAX_CREDENTIAL)) {
+            LOG_ERROR("staged user is invalid");
+            return RESULT_BAD_PARAM;
+        }
+        temp = temp->next;
+    }
+    if (GetUserNum() > MAX_USER) {
+        LOG_ERROR("the number of users exceeds the maximum");
+        return RESULT_EXCEED_LIMIT;
+    }
+    return RESULT_SUCCESS;
+}
+
+static LinkedListNode *QueryUserInfoNode(int32_t userId)
+{
+    LinkedListNode *temp = g_userInfoList->head;
+    while (temp != NULL) {
+        UserInfo *user = (UserInfo *)temp->data;
+        if (user != NULL && user->userId == userId) {
+            return temp;
+        }
+        temp = temp->next;
+    }
+    return NULL;
+}
+
+// Swaps the staged user with its user in g_userInfoList, swapping it again reverts the swap.
+static ResultCode SwapStagedUser(StagedUserInfo *staged)
+{
+    LinkedListNode *node = QueryUserInfoNode(staged->userId);
+    if (node != NULL && staged->user != NULL) {
+        UserInfo *user = (UserInfo *)node->data;
+        node->data = staged->user;
+        staged->user = user;
+        return RESULT_SUCCESS;
+    }
+    if (node != NULL) {
+        UserInfo *user = (UserInfo *)node->data;
+        ResultCode ret = g_userInfoList->remove(g_userInfoList, &staged->userId, MatchUserInfo, false);
+        if (ret != RESULT_SUCCESS) {
+            LOG_ERROR("remove user failed");
+            return ret;
+        }
+        // The list keeps the node when its data is not destroyed.
+        Free(node);
+        staged->user = user;
+        return RESULT_SUCCESS;
+    }
+    if (staged->user != NULL) {
+        ResultCode ret = g_userInfoList->insert(g_userInfoList, staged->user);
+        if (ret != RESULT_SUCCESS) {
+            LOG_ERROR("insert user failed");
+            return ret;
+        }
+        staged->user = NULL;
+    }
+    return RESULT_SUCCESS;
+}
+
+static ResultCode SwapStagedUserInfo(uint32_t maxNum, uint32_t *swapNum)
+{
+    g_currentUser = NULL;
+    *swapNum = 0;
+    LinkedListNode *temp = g_stagedUserList->head;
+    while (temp != NULL && *swapNum < maxNum) {
+        ResultCode ret = SwapStagedUser((StagedUserInfo *)temp->data);
+        if (ret != RESULT_SUCCESS) {
+            return ret;
+        }
+        (*swapNum)++;
+        temp = temp->next;
+    }
+    return RESULT_SUCCESS;
+}
+
+ResultCode BeginUserInfoTransaction(void)
+{
+    if (g_userInfoList == NULL) {
+        LOG_ERROR("please init");
+        return RESULT_NEED_INIT;
+    }
+    if (g_inTransaction) {
+        LOG_ERROR("transaction is already open");
+        return RESULT_BUSY;
+    }
+    g_stagedUserList = CreateLinkedList(DestroyStagedUserInfo);
+    if (g_stagedUserList == NULL) {
+        LOG_ERROR("create staged user list failed");
+        return RESULT_NO_MEMORY;
+    }
+    g_inTransaction = true;
+    g_transactionDirty = false;
+    return RESULT_SUCCESS;
+}
+
+ResultCode CommitUserInfoTransaction(void)
+{
+    if (!g_inTransaction) {
+        LOG_ERROR("no open transaction");
+        return RESULT_BAD_PARAM;
+    }
+    if (!g_transactionDirty) {
+        return RollbackUserInfoTransaction();
+    }
+    ResultCode ret = CheckStagedUserInfo();
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("check staged user failed, roll back");
+        (void)RollbackUserInfoTransaction();
+        return ret;
+    }
+    uint32_t swapNum;
+    ret = SwapStagedUserInfo(UINT32_MAX, &swapNum);
+    if (ret == RESULT_SUCCESS) {
+        // The commit is written even when the persist worker runs, so that its result is the result of the write.
+        ret = WriteUserInfoFile();
+    }
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("apply transaction failed, roll back");
+        if (SwapStagedUserInfo(swapNum, &swapNum) != RESULT_SUCCESS) {
+            LOG_ERROR("revert transaction failed");
+        }
+        (void)RollbackUserInfoTransaction();
+        return ret;
+    }
+    // The staged list now holds the replaced users.
+    DestroyLinkedList(g_stagedUserList);
+    g_stagedUserList = NULL;
+    g_inTransaction = false;
+    g_transactionDirty = false;
+    return RESULT_SUCCESS;
+}
+
+ResultCode RollbackUserInfoTransaction(void)
+{
+    if (!g_inTransaction) {
+        LOG_ERROR("no open transaction");
+        return RESULT_BAD_PARAM;
+    }
+    DiscardStagedUserInfo();
+    g_inTransaction = false;
+    g_transactionDirty = false;
+    return RESULT_SUCCESS;
 }
 
 static bool MatchUserInfo(void *data, void *condition)
@@ -95,6 +557,132 @@ static bool IsUserInfoValid(UserInfo *userInfo)
     return true;
 }
 
+static UserInfoRecord *QueryResidentRecord(int32_t userId)
+{
+    for (uint32_t i = 0; i < g_userIndex->recordNum; i++) {
+        UserInfoRecord *record = &g_userIndex->records[i];
+        if (record->resident && record->userId == userId) {
+            return record;
+        }
+    }
+    return NULL;
+}
+
+// The list is kept in recently used order, the least recently used users are evicted until residentNum are left.
+// Only users which match their record in the file are evicted, so eviction never has to write the file.
+static void EvictUserInfo(uint32_t residentNum)
+{
+    while (g_userInfoList->getSize(g_userInfoList) > residentNum) {
+        UserInfoRecord *victim = NULL;
+        LinkedListNode *temp = g_userInfoList->head;
+        while (temp != NULL) {
+            UserInfo *user = (UserInfo *)temp->data;
+            if (user != NULL && user != g_currentUser) {
+                UserInfoRecord *record = QueryResidentRecord(user->userId);
+                victim = (record != NULL && !record->dirty) ? record : victim;
+            }
+            temp = temp->next;
+        }
+        if (victim == NULL) {
+            LOG_ERROR("no user can be evicted");
+            return;
+        }
+        int32_t userId = victim->userId;
+        if (g_userInfoList->remove(g_userInfoList, &userId, MatchUserInfo, true) != RESULT_SUCCESS) {
+            LOG_ERROR("evict user failed");
+            return;
+        }
+        victim->resident = false;
+    }
+}
+
+static UserInfo *LoadResidentUser(int32_t userId)
+{
+    if (g_userIndex == NULL) {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < g_userIndex->recordNum; i++) {
+        UserInfoRecord *record = &g_userIndex->records[i];
+        if (record->resident || record->userId != userId) {
+            continue;
+        }
+        EvictUserInfo(MAX_RESIDENT_USER - 1);
+        UserInfo *user = LoadUserInfoFromIndex(g_userIndex, i);
+        if (user == NULL) {
+            LOG_ERROR("load user failed");
+            return NULL;
+        }
+        if (g_userInfoList->insert(g_userInfoList, user) != RESULT_SUCCESS) {
+            LOG_ERROR("insert user failed");
+            DestroyUserInfoNode(user);
+            return NULL;
+        }
+        record->resident = true;
+        return user;
+    }
+    return NULL;
+}
+
+static uint32_t GetUserNum(void)
+{
+    uint32_t userNum = g_userInfoList->getSize(g_userInfoList);
+    if (g_inTransaction) {
+        LinkedListNode *temp = g_stagedUserList->head;
+        while (temp != NULL) {
+            StagedUserInfo *staged = (StagedUserInfo *)temp->data;
+            if (staged->user != NULL && !staged->existed) {
+                userNum++;
+            } else if (staged->user == NULL && staged->existed) {
+                userNum--;
+            }
+            temp = temp->next;
+        }
+    }
+    if (g_userIndex == NULL) {
+        return userNum;
+    }
+    for (uint32_t i = 0; i < g_userIndex->recordNum; i++) {
+        if (!g_userIndex->records[i].resident) {
+            userNum++;
+        }
+    }
+    return userNum;
+}
+
+// Users which are not resident are visited through a temporary copy, so that the LRU is not flushed.
+static ResultCode VisitAllUserInfo(UserInfoVisitFunc visitor, void *visitorContext)
+{
+    LinkedListNode *temp = g_userInfoList->head;
+    while (temp != NULL) {
+        UserInfo *user = (UserInfo *)temp->data;
+        temp = temp->next;
+        // Users changed in the open transaction are visited through their copies below.
+        if (g_inTransaction && user != NULL && QueryStagedUser(user->userId) != NULL) {
+            continue;
+        }
+        ResultCode ret = visitor(user, visitorContext);
+        if (ret != RESULT_SUCCESS) {
+            return ret;
+        }
+    }
+    temp = g_inTransaction ? g_stagedUserList->head : NULL;
+    while (temp != NULL) {
+        StagedUserInfo *staged = (StagedUserInfo *)temp->data;
+        temp = temp->next;
+        if (staged->user == NULL) {
+            continue;
+        }
+        ResultCode ret = visitor(staged->user, visitorContext);
+        if (ret != RESULT_SUCCESS) {
+            return ret;
+        }
+    }
+    if (g_userIndex == NULL) {
+        return RESULT_SUCCESS;
+    }
+    return VisitUserInfoFromIndex(g_userIndex, visitor, visitorContext);
+}
+
 ResultCode GetSecureUid(int32_t userId, uint64_t *secUid)
 {
     if (secUid == NULL) {
@@ -159,7 +747,7 @@ ResultCode DeleteUserInfo(int32_t userId, CredentialInfoHal **credentialInfos, u
         LOG_ERROR("param is invalid");
         return RESULT_BAD_PARAM;
     }
-    UserInfo *user = QueryUserInfo(userId);
+    UserInfo *user = QueryUserInfoForUpdate(userId);
     if (!IsUserInfoValid(user)) {
         LOG_ERROR("can't find this user1");
         return RESULT_NOT_FOUND;
@@ -177,7 +765,8 @@ ResultCode DeleteUserInfo(int32_t userId, CredentialInfoHal **credentialInfos, u
         return ret;
     }
 
-    return UpdateFileInfo(g_userInfoList);
+    // The record of the deleted user is marked dirty, so that a user added again with its id is never evicted.
+    return UpdateUserInfoFile(userId);
 }
 
 ResultCode QueryCredentialInfoAll(int32_t userId, CredentialInfoHal **credentialInfos, uint32_t *num)
@@ -196,6 +785,12 @@ ResultCode QueryCredentialInfoAll(int32_t userId, CredentialInfoHal **credential
 
 static UserInfo *QueryUserInfo(int32_t userId)
 {
+    if (g_inTransaction) {
+        StagedUserInfo *staged = QueryStagedUser(userId);
+        if (staged != NULL) {
+            return staged->user;
+        }
+    }
     UserInfo *user = g_currentUser;
     if (user != NULL && user->userId == userId) {
         return user;
@@ -212,7 +807,12 @@ static UserInfo *QueryUserInfo(int32_t userId)
         temp = temp->next;
     }
     if (temp == NULL) {
-        return NULL;
+        user = LoadResidentUser(userId);
+        if (user == NULL) {
+            return NULL;
+        }
+    } else if (g_userIndex != NULL) {
+        (void)g_userInfoList->moveToHead(g_userInfoList, &userId, MatchUserInfo);
     }
     if (IsUserInfoValid(user)) {
         g_currentUser = user;
@@ -312,7 +912,22 @@ static bool IsSecureUidDuplicate(LinkedList *userInfoList, uint64_t secureUid)
         }
         temp = temp->next;
     }
-
+    temp = g_inTransaction ? g_stagedUserList->head : NULL;
+    while (temp != NULL) {
+        StagedUserInfo *staged = (StagedUserInfo *)temp->data;
+        if (staged->user != NULL && staged->user->secUid == secureUid) {
+            return true;
+        }
+        temp = temp->next;
+    }
+    if (g_userIndex == NULL) {
+        return false;
+    }
+    for (uint32_t i = 0; i < g_userIndex->recordNum; i++) {
+        if (!g_userIndex->records[i].resident && g_userIndex->records[i].secUid == secureUid) {
+            return true;
+        }
+    }
     return false;
 }
 
@@ -339,6 +954,16 @@ static ResultCode DeleteUser(int32_t userId)
     if (g_userInfoList == NULL) {
         return RESULT_BAD_PARAM;
     }
+    if (g_inTransaction) {
+        StagedUserInfo *staged = QueryStagedUser(userId);
+        if (staged == NULL || staged->user == NULL) {
+            LOG_ERROR("user is not staged");
+            return RESULT_NOT_FOUND;
+        }
+        DestroyUserInfoNode(staged->user);
+        staged->user = NULL;
+        return RESULT_SUCCESS;
+    }
     return g_userInfoList->remove(g_userInfoList, &userId, MatchUserInfo, true);
 }
 
@@ -477,7 +1102,7 @@ static ResultCode AddUser(int32_t userId, CredentialInfoHal *credentialInfo)
         LOG_ERROR("please init");
         return RESULT_NEED_INIT;
     }
-    if (g_userInfoList->getSize(g_userInfoList) >= MAX_USER) {
+    if (GetUserNum() >= MAX_USER) {
         LOG_ERROR("the number of users reaches the maximum");
         return RESULT_EXCEED_LIMIT;
     }
@@ -500,7 +1125,7 @@ static ResultCode AddUser(int32_t userId, CredentialInfoHal *credentialInfo)
         goto FAIL;
     }
 
-    ret = g_userInfoList->insert(g_userInfoList, user);
+    ret = InsertUserInfo(user);
     if (ret != RESULT_SUCCESS) {
         LOG_ERROR("insert failed");
         goto FAIL;
@@ -518,13 +1143,13 @@ ResultCode AddCredentialInfo(int32_t userId, CredentialInfoHal *credentialInfo)
         LOG_ERROR("credentialInfo is null");
         return RESULT_BAD_PARAM;
     }
-    UserInfo *user = QueryUserInfo(userId);
+    UserInfo *user = QueryUserInfoForUpdate(userId);
     if (user == NULL && credentialInfo->authType == PIN_AUTH) {
         ResultCode ret =  AddUser(userId, credentialInfo);
         if (ret != RESULT_SUCCESS) {
             LOG_ERROR("add user failed");
         }
-        ret = UpdateFileInfo(g_userInfoList);
+        ret = UpdateUserInfoFile(userId);
         if (ret != RESULT_SUCCESS) {
             LOG_ERROR("updateFileInfo failed");
         }
@@ -546,7 +1171,7 @@ ResultCode AddCredentialInfo(int32_t userId, CredentialInfoHal *credentialInfo)
         LOG_ERROR("add credential to user failed");
         return ret;
     }
-    ret = UpdateFileInfo(g_userInfoList);
+    ret = UpdateUserInfoFile(userId);
     if (ret != RESULT_SUCCESS) {
         LOG_ERROR("updateFileInfo failed");
         return ret;
@@ -587,7 +1212,7 @@ ResultCode DeleteCredentialInfo(int32_t userId, uint64_t credentialId, Credentia
         return RESULT_BAD_PARAM;
     }
 
-    UserInfo *user = QueryUserInfo(userId);
+    UserInfo *user = QueryUserInfoForUpdate(userId);
     if (user == NULL) {
         LOG_ERROR("can't find this user");
         return RESULT_BAD_PARAM;
@@ -610,7 +1235,7 @@ ResultCode DeleteCredentialInfo(int32_t userId, uint64_t credentialId, Credentia
     }
     credentialQuery = QueryCredentialByAuthType(credentialInfo->authType, credentialList);
     if (credentialQuery != NULL) {
-        return RESULT_SUCCESS;
+        return UpdateUserInfoFile(userId);
     }
 
     LinkedList *enrolledInfoList = user->enrolledInfoList;
@@ -624,7 +1249,7 @@ ResultCode DeleteCredentialInfo(int32_t userId, uint64_t credentialId, Credentia
         return ret;
     }
 
-    return UpdateFileInfo(g_userInfoList);
+    return UpdateUserInfoFile(userId);
 }
 
 static CredentialInfoHal *QueryCredentialById(uint64_t credentialId, LinkedList *credentialList)
@@ -687,6 +1312,35 @@ ResultCode QueryCredentialInfo(int32_t userId, uint32_t authType, CredentialInfo
     return RESULT_SUCCESS;
 }
 
+static ResultCode AppendCredentialArray(const CredentialInfoHal *credentialInfo, void *visitorContext)
+{
+    CredentialArray *array = (CredentialArray *)visitorContext;
+    if (array->num == array->capacity) {
+        if (array->capacity * MEM_GROWTH_FACTOR > MAX_CREDENTIAL_RETURN) {
+            LOG_ERROR("too large");
+            return RESULT_NO_MEMORY;
+        }
+        uint32_t capacity = array->capacity * MEM_GROWTH_FACTOR;
+        CredentialInfoHal *credentialsTemp = Malloc(sizeof(CredentialInfoHal) * capacity);
+        if (credentialsTemp == NULL) {
+            LOG_ERROR("no memory");
+            return RESULT_NO_MEMORY;
+        }
+        if (memcpy_s(credentialsTemp, sizeof(CredentialInfoHal) * capacity,
+            array->credentialInfos, sizeof(CredentialInfoHal) * array->num) != EOK) {
+            LOG_ERROR("copy failed");
+            Free(credentialsTemp);
+            return RESULT_BAD_COPY;
+        }
+        Free(array->credentialInfos);
+        array->credentialInfos = credentialsTemp;
+        array->capacity = capacity;
+    }
+    array->credentialInfos[array->num] = *credentialInfo;
+    array->num++;
+    return RESULT_SUCCESS;
+}
+
 ResultCode QueryCredentialFromExecutor(uint32_t authType, CredentialInfoHal **credentialInfos, uint32_t *num)
 {
     if (credentialInfos == NULL || num == NULL) {
@@ -696,45 +1350,89 @@ ResultCode QueryCredentialFromExecutor(uint32_t authType, CredentialInfoHal **cr
     if (g_userInfoList == NULL) {
         return RESULT_NEED_INIT;
     }
-    uint32_t preApplyNum = PRE_APPLY_NUM;
-    *credentialInfos = Malloc(preApplyNum * sizeof(CredentialInfoHal));
-    if (*credentialInfos == NULL) {
+    CredentialArray array = {
+        .credentialInfos = Malloc(PRE_APPLY_NUM * sizeof(CredentialInfoHal)),
+        .num = 0,
+        .capacity = PRE_APPLY_NUM,
+    };
+    if (array.credentialInfos == NULL) {
         LOG_ERROR("no memory");
         return RESULT_NO_MEMORY;
     }
-    *num = 0;
-    LinkedListNode *temp = g_userInfoList->head;
+    ResultCode ret = VisitCredentialFromExecutor(authType, AppendCredentialArray, &array);
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("query credential failed");
+        Free(array.credentialInfos);
+        *credentialInfos = NULL;
+        return ret;
+    }
+    *credentialInfos = array.credentialInfos;
+    *num = array.num;
+    return RESULT_SUCCESS;
+}
+
+ResultCode VisitCredentialInfoAll(int32_t userId, CredentialVisitFunc visitor, void *visitorContext)
+{
+    if (visitor == NULL) {
+        LOG_ERROR("visitor is null");
+        return RESULT_BAD_PARAM;
+    }
+    UserInfo *user = QueryUserInfo(userId);
+    if (!IsUserInfoValid(user)) {
+        LOG_ERROR("can't find this user");
+        return RESULT_NOT_FOUND;
+    }
+    LinkedListNode *temp = user->credentialInfoList->head;
     while (temp != NULL) {
-        UserInfo *user = (UserInfo *)temp->data;
-        CredentialInfoHal *credentialQuery = QueryCredentialByAuthType(authType, user->credentialInfoList);
-        if (credentialQuery != NULL) {
-            (*num)++;
-            if (*num <= preApplyNum) {
-                (*credentialInfos)[*num - 1] = *credentialQuery;
-                temp = temp->next;
-                continue;
-            }
-            if (preApplyNum * MEM_GROWTH_FACTOR > MAX_CREDENTIAL_RETURN) {
-                LOG_ERROR("too large");
-                Free(*credentialInfos);
-                *credentialInfos = NULL;
-                return RESULT_NO_MEMORY;
-            }
-            preApplyNum *= MEM_GROWTH_FACTOR;
-            CredentialInfoHal *credentialsTemp = Malloc(sizeof(CredentialInfoHal) * preApplyNum);
-            if (memcpy_s(credentialsTemp, sizeof(CredentialInfoHal) * preApplyNum,
-                *credentialInfos, sizeof(CredentialInfoHal) * (*num - 1)) != EOK) {
-                LOG_ERROR("copy failed");
-                Free(credentialsTemp);
-                Free(*credentialInfos);
-                *credentialInfos = NULL;
-                return RESULT_BAD_COPY;
+        CredentialInfoHal *credentialInfo = (CredentialInfoHal *)temp->data;
+        if (credentialInfo != NULL) {
+            ResultCode ret = visitor(credentialInfo, visitorContext);
+            if (ret != RESULT_SUCCESS) {
+                LOG_ERROR("visit credential failed");
+                return ret;
             }
-            Free(*credentialInfos);
-            *credentialInfos = credentialsTemp;
-            (*credentialInfos)[*num - 1] = *credentialQuery;
         }
         temp = temp->next;
     }
     return RESULT_SUCCESS;
 }
+
+static ResultCode VisitUserCredentialByAuthType(UserInfo *user, void *visitorContext)
+{
+    ExecutorVisitContext *context = (ExecutorVisitContext *)visitorContext;
+    if (user == NULL) {
+        return RESULT_SUCCESS;
+    }
+    CredentialInfoHal *credentialQuery = QueryCredentialByAuthType(context->authType, user->credentialInfoList);
+    if (credentialQuery == NULL) {
+        return RESULT_SUCCESS;
+    }
+    context->num++;
+    if (context->num > MAX_CREDENTIAL_RETURN) {
+        LOG_ERROR("too large");
+        return RESULT_EXCEED_LIMIT;
+    }
+    ResultCode ret = context->visitor(credentialQuery, context->visitorContext);
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("visit credential failed");
+    }
+    return ret;
+}
+
+ResultCode VisitCredentialFromExecutor(uint32_t authType, CredentialVisitFunc visitor, void *visitorContext)
+{
+    if (visitor == NULL) {
+        LOG_ERROR("visitor is null");
+        return RESULT_BAD_PARAM;
+    }
+    if (g_userInfoList == NULL) {
+        return RESULT_NEED_INIT;
+    }
+    ExecutorVisitContext context = {
+        .authType = authType,
+        .num = 0,
+        .visitor = visitor,
+        .visitorContext = visitorContext,
+    };
+    return VisitAllUserInfo(VisitUserCredentialByAuthType, &context);
+}
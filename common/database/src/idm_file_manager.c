@@ -24,9 +24,7 @@
 #include "idm_common.h"
 
 #define IDM_USER_INFO "/data/useriam/userinfo"
-#define MAX_BUFFER_LEN 512000
-#define DEFAULT_EXPANSION_RATIO 2
-#define PRE_APPLY_LEN 2048
+#define FILE_HEAD_LEN (sizeof(uint32_t) + sizeof(uint32_t))
 #define VERSION 0
 
 static uint32_t GetRemainSpace(const Buffer *object)
@@ -39,33 +37,28 @@ static uint8_t *GetStreamAddress(const Buffer *object)
     return object->buf + object->contentSize;
 }
 
-static ResultCode CapacityExpansion(Buffer *object, uint32_t targetCapacity)
+static uint32_t GetUserInfoSize(UserInfo *userInfo)
 {
-    if (!IsBufferValid(object) || object->maxSize > MAX_BUFFER_LEN / DEFAULT_EXPANSION_RATIO) {
-        LOG_ERROR("invalid params");
-        return RESULT_BAD_PARAM;
-    }
-    uint32_t targetSize = object->maxSize;
-    while (targetSize < targetCapacity && targetSize <= MAX_BUFFER_LEN / DEFAULT_EXPANSION_RATIO) {
-        targetSize = targetSize * DEFAULT_EXPANSION_RATIO;
-    }
-    if (targetSize < targetCapacity) {
-        LOG_ERROR("target capacity can not reach");
-        return RESULT_BAD_PARAM;
-    }
-    uint8_t *buf = Malloc(targetSize);
-    if (buf == NULL) {
-        LOG_ERROR("malloc failed");
-        return RESULT_NO_MEMORY;
-    }
-    if (memcpy_s(buf, targetSize, object->buf, object->contentSize) != EOK) {
-        LOG_ERROR("copy failed");
-        Free(buf);
-        return RESULT_NO_MEMORY;
+    LinkedList *credentialList = userInfo->credentialInfoList;
+    LinkedList *enrolledList = userInfo->enrolledInfoList;
+    return sizeof(int32_t) + sizeof(uint64_t) +
+        sizeof(uint32_t) + credentialList->getSize(credentialList) * sizeof(CredentialInfoHal) +
+        sizeof(uint32_t) + enrolledList->getSize(enrolledList) * sizeof(EnrolledInfoHal);
+}
+
+static ResultCode GetUserInfoListSize(LinkedList *userInfoList, uint32_t *size)
+{
+    *size = 0;
+    LinkedListNode *temp = userInfoList->head;
+    while (temp != NULL) {
+        UserInfo *userInfo = (UserInfo *)temp->data;
+        if (userInfo == NULL || userInfo->credentialInfoList == NULL || userInfo->enrolledInfoList == NULL) {
+            LOG_ERROR("userInfo is invalid");
+            return RESULT_NEED_INIT;
+        }
+        *size += GetUserInfoSize(userInfo);
+        temp = temp->next;
     }
-    Free(object->buf);
-    object->buf = buf;
-    object->maxSize = targetSize;
     return RESULT_SUCCESS;
 }
 
@@ -76,11 +69,8 @@ static ResultCode StreamWrite(Buffer *parcel, void *from, uint32_t size)
         return RESULT_BAD_PARAM;
     }
     if (GetRemainSpace(parcel) < size) {
-        ResultCode result = CapacityExpansion(parcel, size);
-        if (result != RESULT_SUCCESS) {
-            LOG_ERROR("CapacityExpansion failed");
-            return result;
-        }
+        LOG_ERROR("the parcel size is miscalculated");
+        return RESULT_BAD_PARAM;
     }
     if (memcpy_s(GetStreamAddress(parcel), GetRemainSpace(parcel), from, size) != EOK) {
         LOG_ERROR("copy failed");
@@ -174,59 +164,83 @@ static ResultCode StreamWriteUserInfo(Buffer *parcel, UserInfo *userInfo)
     return RESULT_SUCCESS;
 }
 
-ResultCode UpdateFileInfo(LinkedList *userInfoList)
+static ResultCode StreamWriteFileHead(Buffer *parcel, uint32_t userNum)
 {
-    LOG_INFO("start");
-    if (userInfoList == NULL) {
-        LOG_ERROR("userInfo list is null");
-        return RESULT_BAD_PARAM;
-    }
-    Buffer *parcel = CreateBuffer(PRE_APPLY_LEN);
-    if (parcel == NULL) {
-        LOG_ERROR("parcel is null");
-        return RESULT_BAD_PARAM;
-    }
     uint32_t version = VERSION;
     ResultCode ret = StreamWrite(parcel, &version, sizeof(uint32_t));
     if (ret != RESULT_SUCCESS) {
         LOG_ERROR("StreamWrite failed");
-        goto EXIT;
+        return ret;
     }
-
-    uint32_t size = userInfoList->getSize(userInfoList);
-    ret = StreamWrite(parcel, &size, sizeof(uint32_t));
+    ret = StreamWrite(parcel, &userNum, sizeof(uint32_t));
     if (ret != RESULT_SUCCESS) {
         LOG_ERROR("StreamWrite failed");
-        goto EXIT;
+        return ret;
     }
+    return RESULT_SUCCESS;
+}
 
+static ResultCode StreamWriteUserInfoList(Buffer *parcel, LinkedList *userInfoList)
+{
+    uint32_t size = userInfoList->getSize(userInfoList);
     LinkedListNode *temp = userInfoList->head;
     for (uint32_t i = 0; i < size; i++) {
         if (temp == NULL || temp->data == NULL) {
             LOG_ERROR("temp is null");
-            ret = RESULT_NEED_INIT;
-            goto EXIT;
+            return RESULT_NEED_INIT;
         }
         if (StreamWriteUserInfo(parcel, (UserInfo *)temp->data) != RESULT_SUCCESS) {
             LOG_ERROR("StreamWriteUserInfo failed");
-            ret = RESULT_GENERAL_ERROR;
-            goto EXIT;
+            return RESULT_GENERAL_ERROR;
         }
         temp = temp->next;
     }
+    return RESULT_SUCCESS;
+}
 
+static ResultCode WriteFileParcel(const Buffer *parcel)
+{
     FileOperator *fileOperator = GetFileOperator(DEFAULT_FILE_OPERATOR);
     if (!IsFileOperatorValid(fileOperator)) {
         LOG_ERROR("invalid file operation");
-        ret = RESULT_BAD_WRITE;
-        goto EXIT;
+        return RESULT_BAD_WRITE;
     }
 
     // This is for example only. Should be implemented in trusted environment.
-    ret = fileOperator->writeFile(IDM_USER_INFO, parcel->buf, parcel->contentSize);
+    ResultCode ret = fileOperator->writeFile(IDM_USER_INFO, parcel->buf, parcel->contentSize);
     if (ret != RESULT_SUCCESS) {
         LOG_ERROR("write file failed, %{public}u", parcel->contentSize);
     }
+    return ret;
+}
+
+ResultCode UpdateFileInfo(LinkedList *userInfoList)
+{
+    LOG_INFO("start");
+    if (userInfoList == NULL) {
+        LOG_ERROR("userInfo list is null");
+        return RESULT_BAD_PARAM;
+    }
+    uint32_t parcelSize;
+    ResultCode ret = GetUserInfoListSize(userInfoList, &parcelSize);
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("get parcel size failed");
+        return ret;
+    }
+    Buffer *parcel = CreateBuffer(FILE_HEAD_LEN + parcelSize);
+    if (parcel == NULL) {
+        LOG_ERROR("parcel is null");
+        return RESULT_NO_MEMORY;
+    }
+    ret = StreamWriteFileHead(parcel, userInfoList->getSize(userInfoList));
+    if (ret != RESULT_SUCCESS) {
+        goto EXIT;
+    }
+    ret = StreamWriteUserInfoList(parcel, userInfoList);
+    if (ret != RESULT_SUCCESS) {
+        goto EXIT;
+    }
+    ret = WriteFileParcel(parcel);
 
 EXIT:
     DestoryBuffer(parcel);
@@ -404,6 +418,376 @@ static bool StreamReadFileInfo(Buffer *parcel, LinkedList *userInfoList)
     return true;
 }
 
+static ResultCode StreamSkip(const Buffer *parcel, uint32_t *index, uint32_t size)
+{
+    if (parcel->contentSize < *index || parcel->contentSize - *index < size) {
+        LOG_ERROR("the buffer length is insufficient");
+        return RESULT_BAD_PARAM;
+    }
+    *index += size;
+    return RESULT_SUCCESS;
+}
+
+static ResultCode StreamSkipInfoList(Buffer *parcel, uint32_t *index, uint32_t infoSize)
+{
+    uint32_t infoNum;
+    ResultCode result = StreamRead(parcel, index, &infoNum, sizeof(uint32_t));
+    if (result != RESULT_SUCCESS) {
+        LOG_ERROR("stream read failed");
+        return RESULT_BAD_READ;
+    }
+    if (infoNum > MAX_CREDENTIAL) {
+        LOG_ERROR("bad info num");
+        return RESULT_BAD_READ;
+    }
+    return StreamSkip(parcel, index, infoNum * infoSize);
+}
+
+static ResultCode StreamReadUserInfoRecord(Buffer *parcel, uint32_t *index, UserInfoRecord *record)
+{
+    record->offset = *index;
+    ResultCode result = StreamRead(parcel, index, &record->userId, sizeof(int32_t));
+    if (result != RESULT_SUCCESS) {
+        LOG_ERROR("Read userId failed");
+        return RESULT_BAD_READ;
+    }
+    result = StreamRead(parcel, index, &record->secUid, sizeof(uint64_t));
+    if (result != RESULT_SUCCESS) {
+        LOG_ERROR("Read secUid failed");
+        return RESULT_BAD_READ;
+    }
+    result = StreamSkipInfoList(parcel, index, sizeof(CredentialInfoHal));
+    if (result != RESULT_SUCCESS) {
+        LOG_ERROR("skip credentialInfoList failed");
+        return result;
+    }
+    result = StreamSkipInfoList(parcel, index, sizeof(EnrolledInfoHal));
+    if (result != RESULT_SUCCESS) {
+        LOG_ERROR("skip enrolledInfoList failed");
+        return result;
+    }
+    record->length = *index - record->offset;
+    record->resident = false;
+    record->dirty = false;
+    return RESULT_SUCCESS;
+}
+
+// Only the offset and length of each record are kept, the parcel is not referenced after the rebuild.
+static ResultCode RebuildUserInfoIndex(UserInfoIndex *userIndex, Buffer *parcel)
+{
+    uint32_t index = 0;
+    uint32_t version;
+    uint32_t userNum;
+    UserInfoRecord *records = NULL;
+    ResultCode result = StreamRead(parcel, &index, &version, sizeof(uint32_t));
+    if (result != RESULT_SUCCESS) {
+        LOG_ERROR("read version failed");
+        return result;
+    }
+    result = StreamRead(parcel, &index, &userNum, sizeof(uint32_t));
+    if (result != RESULT_SUCCESS) {
+        LOG_ERROR("read userNum failed");
+        return result;
+    }
+    if (userNum > MAX_USER) {
+        LOG_ERROR("bad user num");
+        return RESULT_BAD_READ;
+    }
+    if (userNum != 0) {
+        records = Malloc(sizeof(UserInfoRecord) * userNum);
+        if (records == NULL) {
+            LOG_ERROR("records malloc failed");
+            return RESULT_NO_MEMORY;
+        }
+    }
+    for (uint32_t i = 0; i < userNum; i++) {
+        result = StreamReadUserInfoRecord(parcel, &index, &records[i]);
+        if (result != RESULT_SUCCESS) {
+            LOG_ERROR("read record failed");
+            Free(records);
+            return result;
+        }
+    }
+    Free(userIndex->records);
+    userIndex->records = records;
+    userIndex->recordNum = userNum;
+    return RESULT_SUCCESS;
+}
+
+static ResultCode CheckRecordInFile(const Buffer *fileParcel, const UserInfoRecord *record)
+{
+    if (fileParcel->contentSize < record->offset || fileParcel->contentSize - record->offset < record->length) {
+        LOG_ERROR("the record is out of the file");
+        return RESULT_BAD_READ;
+    }
+    return RESULT_SUCCESS;
+}
+
+// Used when the file operator can't read by offset, the record is copied out of the whole file.
+static ResultCode ReadUserInfoRecordFromFile(const UserInfoRecord *record, Buffer *parcel)
+{
+    Buffer *fileParcel = ReadFileInfo();
+    if (fileParcel == NULL) {
+        LOG_ERROR("read file info failed");
+        return RESULT_BAD_READ;
+    }
+    ResultCode ret = CheckRecordInFile(fileParcel, record);
+    if (ret == RESULT_SUCCESS &&
+        memcpy_s(parcel->buf, parcel->maxSize, fileParcel->buf + record->offset, record->length) != EOK) {
+        LOG_ERROR("copy failed");
+        ret = RESULT_BAD_COPY;
+    }
+    DestoryBuffer(fileParcel);
+    return ret;
+}
+
+static Buffer *ReadUserInfoRecord(const UserInfoRecord *record)
+{
+    FileOperator *fileOperator = GetFileOperator(DEFAULT_FILE_OPERATOR);
+    if (!IsFileOperatorValid(fileOperator)) {
+        LOG_ERROR("invalid file operation");
+        return NULL;
+    }
+    Buffer *parcel = CreateBuffer(record->length);
+    if (parcel == NULL) {
+        LOG_ERROR("parcel create failed");
+        return NULL;
+    }
+    ResultCode ret;
+    if (fileOperator->readFileByOffset == NULL) {
+        ret = ReadUserInfoRecordFromFile(record, parcel);
+    } else {
+        ret = fileOperator->readFileByOffset(IDM_USER_INFO, record->offset, parcel->buf, record->length);
+    }
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("read record failed");
+        DestoryBuffer(parcel);
+        return NULL;
+    }
+    parcel->contentSize = record->length;
+    return parcel;
+}
+
+static uint32_t GetEvictedRecordNum(const UserInfoIndex *userIndex)
+{
+    uint32_t evictedNum = 0;
+    for (uint32_t i = 0; i < userIndex->recordNum; i++) {
+        if (!userIndex->records[i].resident) {
+            evictedNum++;
+        }
+    }
+    return evictedNum;
+}
+
+UserInfoIndex *LoadFileIndex(void)
+{
+    LOG_INFO("start");
+    FileOperator *fileOperator = GetFileOperator(DEFAULT_FILE_OPERATOR);
+    if (!IsFileOperatorValid(fileOperator)) {
+        LOG_ERROR("invalid file operation");
+        return NULL;
+    }
+    UserInfoIndex *userIndex = Malloc(sizeof(UserInfoIndex));
+    if (userIndex == NULL) {
+        LOG_ERROR("userIndex malloc failed");
+        return NULL;
+    }
+    (void)memset_s(userIndex, sizeof(UserInfoIndex), 0, sizeof(UserInfoIndex));
+    if (!fileOperator->isFileExist(IDM_USER_INFO)) {
+        LOG_ERROR("file is not exist");
+        return userIndex;
+    }
+    Buffer *parcel = ReadFileInfo();
+    if (parcel == NULL) {
+        LOG_ERROR("read file info failed");
+        Free(userIndex);
+        return NULL;
+    }
+    ResultCode ret = RebuildUserInfoIndex(userIndex, parcel);
+    DestoryBuffer(parcel);
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("build index failed");
+        Free(userIndex);
+        return NULL;
+    }
+    return userIndex;
+}
+
+void DestroyUserInfoIndex(UserInfoIndex *userIndex)
+{
+    if (userIndex == NULL) {
+        return;
+    }
+    Free(userIndex->records);
+    Free(userIndex);
+}
+
+UserInfo *LoadUserInfoFromIndex(UserInfoIndex *userIndex, uint32_t recordIndex)
+{
+    if (userIndex == NULL || recordIndex >= userIndex->recordNum) {
+        LOG_ERROR("invalid params");
+        return NULL;
+    }
+    Buffer *parcel = ReadUserInfoRecord(&userIndex->records[recordIndex]);
+    if (parcel == NULL) {
+        LOG_ERROR("read record failed");
+        return NULL;
+    }
+    UserInfo *userInfo = InitUserInfoNode();
+    if (userInfo == NULL) {
+        LOG_ERROR("userInfoNode init failed");
+        DestoryBuffer(parcel);
+        return NULL;
+    }
+    uint32_t index = 0;
+    if (StreamReadUserInfo(parcel, &index, userInfo) != RESULT_SUCCESS) {
+        LOG_ERROR("read user info failed");
+        DestroyUserInfoNode(userInfo);
+        DestoryBuffer(parcel);
+        return NULL;
+    }
+    DestoryBuffer(parcel);
+    return userInfo;
+}
+
+static UserInfo *StreamReadUserInfoRecordData(Buffer *fileParcel, const UserInfoRecord *record)
+{
+    if (CheckRecordInFile(fileParcel, record) != RESULT_SUCCESS) {
+        return NULL;
+    }
+    UserInfo *userInfo = InitUserInfoNode();
+    if (userInfo == NULL) {
+        LOG_ERROR("userInfoNode init failed");
+        return NULL;
+    }
+    uint32_t index = record->offset;
+    if (StreamReadUserInfo(fileParcel, &index, userInfo) != RESULT_SUCCESS) {
+        LOG_ERROR("read user info failed");
+        DestroyUserInfoNode(userInfo);
+        return NULL;
+    }
+    return userInfo;
+}
+
+// The file is read once for all the users which are not resident, each one is visited through a temporary copy.
+ResultCode VisitUserInfoFromIndex(UserInfoIndex *userIndex, UserInfoVisitFunc visitor, void *visitorContext)
+{
+    if (userIndex == NULL || visitor == NULL) {
+        LOG_ERROR("invalid params");
+        return RESULT_BAD_PARAM;
+    }
+    if (GetEvictedRecordNum(userIndex) == 0) {
+        return RESULT_SUCCESS;
+    }
+    Buffer *fileParcel = ReadFileInfo();
+    if (fileParcel == NULL) {
+        LOG_ERROR("read file info failed");
+        return RESULT_BAD_READ;
+    }
+    ResultCode ret = RESULT_SUCCESS;
+    for (uint32_t i = 0; i < userIndex->recordNum; i++) {
+        if (userIndex->records[i].resident) {
+            continue;
+        }
+        UserInfo *userInfo = StreamReadUserInfoRecordData(fileParcel, &userIndex->records[i]);
+        if (userInfo == NULL) {
+            LOG_ERROR("read record failed");
+            ret = RESULT_BAD_READ;
+            break;
+        }
+        ret = visitor(userInfo, visitorContext);
+        DestroyUserInfoNode(userInfo);
+        if (ret != RESULT_SUCCESS) {
+            break;
+        }
+    }
+    DestoryBuffer(fileParcel);
+    return ret;
+}
+
+static ResultCode StreamWriteUserInfoRecord(Buffer *parcel, const Buffer *fileParcel, const UserInfoRecord *record)
+{
+    ResultCode ret = CheckRecordInFile(fileParcel, record);
+    if (ret != RESULT_SUCCESS) {
+        return ret;
+    }
+    return StreamWrite(parcel, fileParcel->buf + record->offset, record->length);
+}
+
+// The index is rebuilt only when the file is written, the records of evicted users stay valid if the write fails.
+// The records of evicted users are copied from a single read of the current file.
+ResultCode UpdateFileInfoWithIndex(LinkedList *userInfoList, UserInfoIndex *userIndex)
+{
+    LOG_INFO("start");
+    if (userInfoList == NULL || userIndex == NULL) {
+        LOG_ERROR("invalid params");
+        return RESULT_BAD_PARAM;
+    }
+    uint32_t residentNum = userInfoList->getSize(userInfoList);
+    uint32_t parcelSize;
+    ResultCode ret = GetUserInfoListSize(userInfoList, &parcelSize);
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("get parcel size failed");
+        return ret;
+    }
+    for (uint32_t i = 0; i < userIndex->recordNum; i++) {
+        if (!userIndex->records[i].resident) {
+            parcelSize += userIndex->records[i].length;
+        }
+    }
+    uint32_t evictedNum = GetEvictedRecordNum(userIndex);
+    Buffer *fileParcel = NULL;
+    if (evictedNum != 0) {
+        fileParcel = ReadFileInfo();
+        if (fileParcel == NULL) {
+            LOG_ERROR("read file info failed");
+            return RESULT_BAD_READ;
+        }
+    }
+    Buffer *parcel = CreateBuffer(FILE_HEAD_LEN + parcelSize);
+    if (parcel == NULL) {
+        LOG_ERROR("parcel is null");
+        DestoryBuffer(fileParcel);
+        return RESULT_NO_MEMORY;
+    }
+    ret = StreamWriteFileHead(parcel, residentNum + evictedNum);
+    if (ret != RESULT_SUCCESS) {
+        goto EXIT;
+    }
+    ret = StreamWriteUserInfoList(parcel, userInfoList);
+    if (ret != RESULT_SUCCESS) {
+        goto EXIT;
+    }
+    for (uint32_t i = 0; i < userIndex->recordNum; i++) {
+        if (userIndex->records[i].resident) {
+            continue;
+        }
+        ret = StreamWriteUserInfoRecord(parcel, fileParcel, &userIndex->records[i]);
+        if (ret != RESULT_SUCCESS) {
+            LOG_ERROR("record streamWrite failed");
+            goto EXIT;
+        }
+    }
+    ret = WriteFileParcel(parcel);
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("write file failed");
+        goto EXIT;
+    }
+    ret = RebuildUserInfoIndex(userIndex, parcel);
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("rebuild index failed");
+        goto EXIT;
+    }
+    for (uint32_t i = 0; i < residentNum; i++) {
+        userIndex->records[i].resident = true;
+    }
+
+EXIT:
+    DestoryBuffer(fileParcel);
+    DestoryBuffer(parcel);
+    return ret;
+}
+
 LinkedList *LoadFileInfo(void)
 {
     LOG_INFO("start");
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "idm_persist_worker.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "adaptor_log.h"
+#include "lock.h"
+
+// Mutations notified within this window are written by a single persist task.
+#define PERSIST_COALESCE_WINDOW_MS 100
+#define MS_PER_SECOND 1000
+#define NS_PER_MS 1000000
+#define NS_PER_SECOND 1000000000
+
+static pthread_mutex_t g_workerMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_workerCond;
+
+static pthread_t g_worker;
+static bool g_workerStarted = false;
+static bool g_stopRequested = false;
+static bool g_persistPending = false;
+static PersistTask g_persistTask = NULL;
+
+static struct timespec GetCoalesceDeadline(void)
+{
+    struct timespec deadline;
+    (void)clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += PERSIST_COALESCE_WINDOW_MS / MS_PER_SECOND;
+    deadline.tv_nsec += (PERSIST_COALESCE_WINDOW_MS % MS_PER_SECOND) * NS_PER_MS;
+    if (deadline.tv_nsec >= NS_PER_SECOND) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= NS_PER_SECOND;
+    }
+    return deadline;
+}
+
+// Called with g_workerMutex held, returns false when the worker is asked to stop during the window.
+static bool WaitCoalesceWindow(void)
+{
+    struct timespec deadline = GetCoalesceDeadline();
+    while (!g_stopRequested) {
+        if (pthread_cond_timedwait(&g_workerCond, &g_workerMutex, &deadline) == ETIMEDOUT) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void *PersistWorkerLoop(void *arg)
+{
+    (void)arg;
+    (void)pthread_mutex_lock(&g_workerMutex);
+    while (!g_stopRequested) {
+        if (!g_persistPending) {
+            (void)pthread_cond_wait(&g_workerCond, &g_workerMutex);
+            continue;
+        }
+        if (!WaitCoalesceWindow()) {
+            break;
+        }
+        // The worker is stopped with the global lock held, so it is only tried, a busy lock waits another window.
+        if (!GlobalTryLock()) {
+            continue;
+        }
+        g_persistPending = false;
+        PersistTask task = g_persistTask;
+        (void)pthread_mutex_unlock(&g_workerMutex);
+        task();
+        GlobalUnLock();
+        (void)pthread_mutex_lock(&g_workerMutex);
+    }
+    (void)pthread_mutex_unlock(&g_workerMutex);
+    return NULL;
+}
+
+static bool InitWorkerCond(void)
+{
+    pthread_condattr_t attr;
+    if (pthread_condattr_init(&attr) != 0) {
+        return false;
+    }
+    bool ret = (pthread_condattr_setclock(&attr, CLOCK_MONOTONIC) == 0) &&
+        (pthread_cond_init(&g_workerCond, &attr) == 0);
+    (void)pthread_condattr_destroy(&attr);
+    return ret;
+}
+
+ResultCode StartPersistWorker(PersistTask task)
+{
+    if (task == NULL) {
+        LOG_ERROR("task is null");
+        return RESULT_BAD_PARAM;
+    }
+    (void)pthread_mutex_lock(&g_workerMutex);
+    g_persistTask = task;
+    if (g_workerStarted) {
+        (void)pthread_mutex_unlock(&g_workerMutex);
+        return RESULT_SUCCESS;
+    }
+    if (!InitWorkerCond()) {
+        LOG_ERROR("init persist worker cond failed");
+        (void)pthread_mutex_unlock(&g_workerMutex);
+        return RESULT_GENERAL_ERROR;
+    }
+    if (pthread_create(&g_worker, NULL, PersistWorkerLoop, NULL) != 0) {
+        LOG_ERROR("create persist worker failed");
+        (void)pthread_cond_destroy(&g_workerCond);
+        (void)pthread_mutex_unlock(&g_workerMutex);
+        return RESULT_GENERAL_ERROR;
+    }
+    g_workerStarted = true;
+    (void)pthread_mutex_unlock(&g_workerMutex);
+    LOG_INFO("persist worker started");
+    return RESULT_SUCCESS;
+}
+
+void StopPersistWorker(void)
+{
+    (void)pthread_mutex_lock(&g_workerMutex);
+    if (!g_workerStarted) {
+        (void)pthread_mutex_unlock(&g_workerMutex);
+        return;
+    }
+    g_stopRequested = true;
+    (void)pthread_cond_signal(&g_workerCond);
+    (void)pthread_mutex_unlock(&g_workerMutex);
+
+    (void)pthread_join(g_worker, NULL);
+
+    (void)pthread_mutex_lock(&g_workerMutex);
+    (void)pthread_cond_destroy(&g_workerCond);
+    g_workerStarted = false;
+    g_stopRequested = false;
+    g_persistPending = false;
+    g_persistTask = NULL;
+    (void)pthread_mutex_unlock(&g_workerMutex);
+    LOG_INFO("persist worker stopped");
+}
+
+void NotifyPersistWorker(void)
+{
+    (void)pthread_mutex_lock(&g_workerMutex);
+    if (g_workerStarted) {
+        g_persistPending = true;
+        (void)pthread_cond_signal(&g_workerCond);
+    }
+    (void)pthread_mutex_unlock(&g_workerMutex);
+}
@@ -21,6 +21,7 @@ extern "C" {
 #include "coauth_funcs.h"
 #include "defines.h"
 #include "adaptor_log.h"
+#include "adaptor_memory.h"
 #include "lock.h"
 }
 
@@ -103,7 +104,7 @@ int32_t DeleteScheduleInfo(uint64_t scheduleId, ScheduleInfo &scheduleInfo)
 static Buffer *CreateBufferByVector(std::vector<uint8_t> &executorFinishMsg)
 {
     LOG_INFO("executorFinishMsg size is %{public}zu", executorFinishMsg.size());
-    Buffer *data = CreateBufferByData(&executorFinishMsg[0], executorFinishMsg.size());
+    Buffer *data = CreateArenaBufferByData(&executorFinishMsg[0], executorFinishMsg.size());
     return data;
 }
 
@@ -116,31 +117,60 @@ int32_t GetScheduleToken(std::vector<uint8_t> executorFinishMsg, ScheduleToken &
         return DeleteScheduleInfo(scheduleToken.scheduleId, scheduleInfo);
     }
     GlobalLock();
+    // The message and everything parsed from it live in the call's arena.
+    BeginMemoryArena();
     Buffer *executorMsg = CreateBufferByVector(executorFinishMsg);
     if (executorMsg == nullptr) {
         LOG_ERROR("create msg failed");
+        EndMemoryArena();
         GlobalUnLock();
         return RESULT_NO_MEMORY;
     }
     ScheduleTokenHal scheduleTokenHal = {};
     scheduleTokenHal.scheduleId = scheduleToken.scheduleId;
     int32_t ret = ScheduleFinish(executorMsg, &scheduleTokenHal);
+    DestoryBuffer(executorMsg);
+    EndMemoryArena();
     if (ret != RESULT_SUCCESS) {
-        DestoryBuffer(executorMsg);
         GlobalUnLock();
         return ret;
     }
     if (memcpy_s(&scheduleToken, sizeof(ScheduleToken), &scheduleTokenHal, sizeof(ScheduleTokenHal)) != EOK) {
         LOG_ERROR("copy scheduleToken failed");
-        DestoryBuffer(executorMsg);
         GlobalUnLock();
         return RESULT_BAD_COPY;
     }
-    DestoryBuffer(executorMsg);
     GlobalUnLock();
     return RESULT_SUCCESS;
 }
 
+int32_t VerifyScheduleTokens(const std::vector<ScheduleToken> &scheduleTokens, std::vector<int32_t> &results)
+{
+    LOG_INFO("start");
+    results.clear();
+    if (scheduleTokens.empty() || scheduleTokens.size() > MAX_VERIFY_TOKEN_NUM) {
+        LOG_ERROR("bad token num");
+        return RESULT_BAD_PARAM;
+    }
+    std::vector<ScheduleTokenHal> scheduleTokensHal(scheduleTokens.size());
+    for (uint32_t i = 0; i < scheduleTokens.size(); i++) {
+        if (memcpy_s(&scheduleTokensHal[i], sizeof(ScheduleTokenHal), &scheduleTokens[i],
+            sizeof(ScheduleToken)) != EOK) {
+            LOG_ERROR("copy scheduleToken failed");
+            return RESULT_BAD_COPY;
+        }
+    }
+    std::vector<ResultCode> resultsHal(scheduleTokens.size());
+    GlobalLock();
+    int32_t ret = CoAuthTokenVerifyBatch(&scheduleTokensHal[0], scheduleTokensHal.size(), &resultsHal[0]);
+    GlobalUnLock();
+    if (ret == RESULT_BAD_PARAM) {
+        return ret;
+    }
+    results.assign(resultsHal.begin(), resultsHal.end());
+    return ret;
+}
+
 int32_t ExecutorRegister(ExecutorInfo executorInfo, uint64_t &executorId)
 {
     LOG_INFO("start");
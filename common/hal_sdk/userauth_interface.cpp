@@ -15,10 +15,13 @@
 
 #include "userauth_interface.h"
 
+#include <memory>
+
 #include "securec.h"
 
 extern "C" {
 #include "adaptor_log.h"
+#include "adaptor_memory.h"
 #include "user_auth_funcs.h"
 #include "coauth_interface.h"
 #include "auth_level.h"
@@ -49,49 +52,56 @@ int32_t GenerateSolution(AuthSolution param, std::vector<uint64_t> &scheduleIds)
     for (uint32_t i = 0; i < scheduleIdNum; i++) {
         scheduleIds.push_back(scheduleIdsGet[i]);
     }
-    free(scheduleIdsGet);
+    Free(scheduleIdsGet);
     GlobalUnLock();
     return RESULT_SUCCESS;
 }
 
+static int32_t RequestAuthResultInArena(uint64_t contextId, const std::vector<uint8_t> &scheduleToken,
+    UserAuthTokenHal &authTokenHal, uint64_t **scheduleIds, uint32_t *scheduleIdNum)
+{
+    std::unique_ptr<Buffer, decltype(&DestoryBuffer)> scheduleTokenBuffer(
+        CreateArenaBufferByData(&scheduleToken[0], scheduleToken.size()), DestoryBuffer);
+    if (scheduleTokenBuffer == nullptr) {
+        LOG_ERROR("copy scheduleToken failed");
+        return RESULT_BAD_COPY;
+    }
+    return RequestAuthResultFunc(contextId, scheduleTokenBuffer.get(), &authTokenHal, scheduleIds, scheduleIdNum);
+}
+
 int32_t RequestAuthResult(uint64_t contextId, std::vector<uint8_t> &scheduleToken, UserAuthToken &authToken,
     std::vector<uint64_t> &scheduleIds)
 {
     LOG_INFO("start");
-    GlobalLock();
-    if (scheduleToken.size() != sizeof(CoAuth::ScheduleToken)) {
+    // Several schedule tokens of the context may come together, they are verified in one batch.
+    if (scheduleToken.empty() || scheduleToken.size() % sizeof(CoAuth::ScheduleToken) != 0 ||
+        scheduleToken.size() / sizeof(CoAuth::ScheduleToken) > MAX_VERIFY_TOKEN_NUM) {
         LOG_ERROR("param is invalid");
-        GlobalUnLock();
         return RESULT_BAD_PARAM;
     }
-    Buffer *scheduleTokenBuffer = CreateBufferByData(&scheduleToken[0], scheduleToken.size());
-    if (scheduleTokenBuffer == nullptr) {
-        LOG_ERROR("scheduleTokenBuffer is null");
-        GlobalUnLock();
-        return RESULT_NO_MEMORY;
-    }
+    GlobalLock();
     UserAuthTokenHal authTokenHal;
     uint64_t *scheduleIdsGet = nullptr;
     uint32_t scheduleIdNum = 0;
-    int32_t ret = RequestAuthResultFunc(contextId, scheduleTokenBuffer, &authTokenHal, &scheduleIdsGet, &scheduleIdNum);
+    // The tokens and the copies verified from them live in the call's arena.
+    BeginMemoryArena();
+    int32_t ret = RequestAuthResultInArena(contextId, scheduleToken, authTokenHal, &scheduleIdsGet, &scheduleIdNum);
+    EndMemoryArena();
     if (ret != RESULT_SUCCESS) {
         LOG_ERROR("execute func failed");
-        DestoryBuffer(scheduleTokenBuffer);
         GlobalUnLock();
         return ret;
     }
     if (memcpy_s(&authToken, sizeof(UserAuthToken), &authTokenHal, sizeof(UserAuthTokenHal)) != EOK) {
         LOG_ERROR("copy authToken failed");
-        free(scheduleIdsGet);
-        DestoryBuffer(scheduleTokenBuffer);
+        Free(scheduleIdsGet);
         GlobalUnLock();
         return RESULT_BAD_COPY;
     }
     for (uint32_t i = 0; i < scheduleIdNum; i++) {
         scheduleIds.push_back(scheduleIdsGet[i]);
     }
-    free(scheduleIdsGet);
-    DestoryBuffer(scheduleTokenBuffer);
+    Free(scheduleIdsGet);
     GlobalUnLock();
     return RESULT_SUCCESS;
 }
@@ -111,11 +121,37 @@ int32_t CancelContext(uint64_t contextId, std::vector<uint64_t> &scheduleIds)
     for (uint32_t i = 0; i < scheduleIdNum; i++) {
         scheduleIds.push_back(scheduleIdsGet[i]);
     }
-    free(scheduleIdsGet);
+    Free(scheduleIdsGet);
     GlobalUnLock();
     return RESULT_SUCCESS;
 }
 
+int32_t VerifyAuthTokens(const std::vector<UserAuthToken> &authTokens, std::vector<int32_t> &results)
+{
+    LOG_INFO("start");
+    results.clear();
+    if (authTokens.empty() || authTokens.size() > MAX_VERIFY_TOKEN_NUM) {
+        LOG_ERROR("bad token num");
+        return RESULT_BAD_PARAM;
+    }
+    std::vector<UserAuthTokenHal> authTokensHal(authTokens.size());
+    for (uint32_t i = 0; i < authTokens.size(); i++) {
+        if (memcpy_s(&authTokensHal[i], sizeof(UserAuthTokenHal), &authTokens[i], sizeof(UserAuthToken)) != EOK) {
+            LOG_ERROR("copy authToken failed");
+            return RESULT_BAD_COPY;
+        }
+    }
+    std::vector<ResultCode> resultsHal(authTokens.size());
+    GlobalLock();
+    int32_t ret = UserAuthTokenVerifyBatch(&authTokensHal[0], authTokensHal.size(), &resultsHal[0]);
+    GlobalUnLock();
+    if (ret == RESULT_BAD_PARAM) {
+        return ret;
+    }
+    results.assign(resultsHal.begin(), resultsHal.end());
+    return ret;
+}
+
 int32_t GetAuthTrustLevel(int32_t userId, uint32_t authType, uint32_t &authTrustLevel)
 {
     LOG_INFO("start");
@@ -15,6 +15,8 @@
 
 #include "useriam_common.h"
 
+#include <algorithm>
+
 extern "C" {
 #include <sys/stat.h>
 #include <unistd.h>
@@ -23,7 +25,9 @@ extern "C" {
 #include "idm_database.h"
 #include "coauth.h"
 #include "context_manager.h"
+#include "adaptor_algorithm.h"
 #include "adaptor_log.h"
+#include "adaptor_memory.h"
 #include "lock.h"
 #include "token_key.h"
 }
@@ -41,6 +45,7 @@ int32_t Init()
     if (IDM_USER_FOLDER && access(IDM_USER_FOLDER, 0) == -1) {
         mkdir(IDM_USER_FOLDER, S_IRWXU);
     }
+    ResetSecureRandomPool();
     if (InitUserAuthContextList() != RESULT_SUCCESS) {
         LOG_ERROR("init user auth failed");
         goto FAIL;
@@ -79,6 +84,7 @@ int32_t Close()
     DestoryCoAuth();
     DestroyUserInfoList();
     DestroyResourcePool();
+    DestroyMemoryPool();
     g_isInitUserIAM = false;
     GlobalUnLock();
     return RESULT_SUCCESS;
@@ -88,6 +94,32 @@ bool IsIAMInited()
 {
     return g_isInitUserIAM;
 }
+
+void GetMemoryDumpInfo(std::string &info)
+{
+    info.append("useriam common memory:\n");
+#ifndef MEMORY_STATS
+    info.append("  not collected, build with useriam_memory_stats = true\n");
+#else
+    MemoryStats stats;
+    GetMemoryStats(&stats);
+    info.append("  live bytes: " + std::to_string(stats.liveBytes) + "\n");
+    info.append("  peak bytes: " + std::to_string(stats.peakBytes) + "\n");
+    info.append("  heap malloc count: " + std::to_string(stats.mallocCount) + "\n");
+    info.append("  heap free count: " + std::to_string(stats.freeCount) + "\n");
+
+    std::vector<MemorySiteStats> sites(MAX_MEMORY_SITE_NUM);
+    sites.resize(GetMemorySiteStats(sites.data(), MAX_MEMORY_SITE_NUM));
+    std::sort(sites.begin(), sites.end(), [](const MemorySiteStats &left, const MemorySiteStats &right) {
+        return left.mallocCount > right.mallocCount;
+    });
+    info.append("  allocations by site (count, bytes):\n");
+    for (const auto &site : sites) {
+        info.append("    " + std::string(site.site) + ": " + std::to_string(site.mallocCount) + ", " +
+            std::to_string(site.mallocBytes) + "\n");
+    }
+#endif
+}
 } // Common
 } // UserIAM
 } // OHOS
\ No newline at end of file
@@ -22,6 +22,7 @@ extern "C" {
 #include "idm_session.h"
 #include "user_idm_funcs.h"
 #include "adaptor_log.h"
+#include "adaptor_memory.h"
 #include "coauth_interface.h"
 #include "coauth_sign_centre.h"
 #include "idm_database.h"
@@ -129,31 +130,66 @@ int32_t DeleteCredential(int32_t userId, uint64_t credentialId, std::vector<uint
     return RESULT_SUCCESS;
 }
 
-int32_t QueryCredential(int32_t userId, uint32_t authType, std::vector<CredentialInfo> &credentialInfos)
+int32_t DeleteCredentials(int32_t userId, const std::vector<uint64_t> &credentialIds, std::vector<uint8_t> authToken,
+    std::vector<CredentialInfo> &credentialInfos)
 {
     LOG_INFO("start");
     GlobalLock();
-    CredentialInfoHal *credentialInfoHals = nullptr;
-    uint32_t num = 0;
-    int32_t ret = QueryCredentialFunc(userId, authType, &credentialInfoHals, &num);
+    authToken.resize(sizeof(UserAuth::UserAuthToken));
+    CredentialsDeleteParam param;
+    if (memcpy_s(param.token, AUTH_TOKEN_LEN, &authToken[0], authToken.size()) != EOK) {
+        LOG_ERROR("param token copy failed");
+        GlobalUnLock();
+        return RESULT_BAD_COPY;
+    }
+    param.userId = userId;
+    param.credentialIds = credentialIds.data();
+    param.credentialNum = credentialIds.size();
+    std::vector<CredentialInfoHal> credentialInfoHals(credentialIds.size());
+    int32_t ret = DeleteCredentialsFunc(param, credentialInfoHals.data());
     if (ret != RESULT_SUCCESS) {
-        LOG_ERROR("query credential failed");
+        LOG_ERROR("delete failed");
         GlobalUnLock();
         return ret;
     }
-    for (int i = 0; i < num; i++) {
-        CredentialInfo credentialInfo;
-        if (memcpy_s(&credentialInfo, sizeof(CredentialInfo),
-            &credentialInfoHals[i], sizeof(CredentialInfoHal)) != EOK) {
-            LOG_ERROR("credentialInfo copy failed");
-            free(credentialInfoHals);
+    credentialInfos.resize(credentialInfoHals.size());
+    for (uint32_t i = 0; i < credentialInfoHals.size(); i++) {
+        if (memcpy_s(&credentialInfos[i], sizeof(CredentialInfo), &credentialInfoHals[i],
+            sizeof(CredentialInfoHal)) != EOK) {
+            LOG_ERROR("copy failed");
             credentialInfos.clear();
             GlobalUnLock();
             return RESULT_BAD_COPY;
         }
-        credentialInfos.push_back(credentialInfo);
     }
-    free(credentialInfoHals);
+    GlobalUnLock();
+    return RESULT_SUCCESS;
+}
+
+static ResultCode AppendCredentialInfo(const CredentialInfoHal *credentialInfoHal, void *visitorContext)
+{
+    auto credentialInfos = static_cast<std::vector<CredentialInfo> *>(visitorContext);
+    credentialInfos->emplace_back();
+    CredentialInfo &credentialInfo = credentialInfos->back();
+    if (memcpy_s(&credentialInfo, sizeof(CredentialInfo), credentialInfoHal, sizeof(CredentialInfoHal)) != EOK) {
+        LOG_ERROR("credentialInfo copy failed");
+        return RESULT_BAD_COPY;
+    }
+    return RESULT_SUCCESS;
+}
+
+int32_t QueryCredential(int32_t userId, uint32_t authType, std::vector<CredentialInfo> &credentialInfos)
+{
+    LOG_INFO("start");
+    GlobalLock();
+    credentialInfos.reserve(credentialInfos.size() + MAX_CREDENTIAL);
+    int32_t ret = VisitCredentialFunc(userId, authType, AppendCredentialInfo, &credentialInfos);
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("query credential failed");
+        credentialInfos.clear();
+        GlobalUnLock();
+        return ret;
+    }
     GlobalUnLock();
     return RESULT_SUCCESS;
 }
@@ -174,14 +210,14 @@ int32_t GetSecureUid(int32_t userId, uint64_t &secureUid, std::vector<EnrolledIn
         EnrolledInfo enrolledInfo;
         if (memcpy_s(&enrolledInfo, sizeof(EnrolledInfo), &enrolledInfoHals[i], sizeof(EnrolledInfoHal)) != EOK) {
             LOG_ERROR("credentialInfo copy failed");
-            free(enrolledInfoHals);
+            Free(enrolledInfoHals);
             enrolledInfos.clear();
             GlobalUnLock();
             return RESULT_BAD_COPY;
         }
         enrolledInfos.push_back(enrolledInfo);
     }
-    free(enrolledInfoHals);
+    Free(enrolledInfoHals);
     GlobalUnLock();
     return RESULT_SUCCESS;
 }
@@ -192,9 +228,24 @@ int32_t DeleteUserEnforce(int32_t userId, std::vector<CredentialInfo> &credentia
     GlobalLock();
     CredentialInfoHal *credentialInfoHals = nullptr;
     uint32_t num = 0;
-    int32_t ret = DeleteUserInfo(userId, &credentialInfoHals, &num);
+    // The user is removed in a transaction, so that it is persisted before the result and kept if the write fails.
+    int32_t ret = BeginUserInfoTransaction();
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("begin transaction failed");
+        GlobalUnLock();
+        return ret;
+    }
+    ret = DeleteUserInfo(userId, &credentialInfoHals, &num);
     if (ret != RESULT_SUCCESS) {
         LOG_ERROR("query credential failed");
+        (void)RollbackUserInfoTransaction();
+        GlobalUnLock();
+        return ret;
+    }
+    ret = CommitUserInfoTransaction();
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("commit transaction failed");
+        Free(credentialInfoHals);
         GlobalUnLock();
         return ret;
     }
@@ -204,14 +255,14 @@ int32_t DeleteUserEnforce(int32_t userId, std::vector<CredentialInfo> &credentia
         if (memcpy_s(&credentialInfo, sizeof(CredentialInfo),
             &credentialInfoHals[i], sizeof(CredentialInfoHal)) != EOK) {
             LOG_ERROR("credentialInfo copy failed");
-            free(credentialInfoHals);
+            Free(credentialInfoHals);
             credentialInfos.clear();
             GlobalUnLock();
             return RESULT_BAD_COPY;
         }
         credentialInfos.push_back(credentialInfo);
     }
-    free(credentialInfoHals);
+    Free(credentialInfoHals);
     GlobalUnLock();
     return RESULT_SUCCESS;
 }
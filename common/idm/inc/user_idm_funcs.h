@@ -33,11 +33,20 @@ typedef struct {
     uint64_t credentialId;
 } CredentialDeleteParam;
 
+typedef struct {
+    uint8_t token[AUTH_TOKEN_LEN];
+    int32_t userId;
+    const uint64_t *credentialIds;
+    uint32_t credentialNum;
+} CredentialsDeleteParam;
+
 int32_t CheckEnrollPermission(PermissionCheckParam param, uint64_t *scheduleId);
 int32_t AddCredentialFunc(const uint8_t *enrollToken, uint32_t tokenLen, uint64_t *credentialId);
 int32_t DeleteCredentialFunc(CredentialDeleteParam param, CredentialInfoHal *credentialInfo);
+int32_t DeleteCredentialsFunc(CredentialsDeleteParam param, CredentialInfoHal *credentialInfos);
 int32_t QueryCredentialFunc(int32_t userId, uint32_t authType,
     CredentialInfoHal **credentialInfoArray, uint32_t *credentialNum);
+int32_t VisitCredentialFunc(int32_t userId, uint32_t authType, CredentialVisitFunc visitor, void *visitorContext);
 int32_t GetUserSecureUidFunc(int32_t userId, uint64_t *secureUid, EnrolledInfoHal **enrolledInfoArray,
     uint32_t *enrolledNum);
 int32_t CancelScheduleIdFunc(uint64_t *scheduleId);
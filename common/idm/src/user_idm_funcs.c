@@ -172,14 +172,10 @@ int32_t AddCredentialFunc(const uint8_t *enrollToken, uint32_t tokenLen, uint64_
     return ret;
 }
 
-int32_t DeleteCredentialFunc(CredentialDeleteParam param, CredentialInfoHal *credentialInfo)
+static int32_t CheckDeleteToken(const uint8_t *tokenData)
 {
-    if (credentialInfo == NULL) {
-        LOG_ERROR("param is null");
-        return RESULT_BAD_PARAM;
-    }
     UserAuthTokenHal token;
-    if (memcpy_s(&token, sizeof(UserAuthTokenHal), param.token, AUTH_TOKEN_LEN) != EOK) {
+    if (memcpy_s(&token, sizeof(UserAuthTokenHal), tokenData, AUTH_TOKEN_LEN) != EOK) {
         LOG_ERROR("token copy failed");
         return RESULT_BAD_COPY;
     }
@@ -196,6 +192,19 @@ int32_t DeleteCredentialFunc(CredentialDeleteParam param, CredentialInfoHal *cre
         LOG_ERROR("failed to verify the token");
         return RESULT_BAD_SIGN;
     }
+    return RESULT_SUCCESS;
+}
+
+int32_t DeleteCredentialFunc(CredentialDeleteParam param, CredentialInfoHal *credentialInfo)
+{
+    if (credentialInfo == NULL) {
+        LOG_ERROR("param is null");
+        return RESULT_BAD_PARAM;
+    }
+    int32_t ret = CheckDeleteToken(param.token);
+    if (ret != RESULT_SUCCESS) {
+        return ret;
+    }
     ret = DeleteCredentialInfo(param.userId, param.credentialId, credentialInfo);
     if (ret != RESULT_SUCCESS) {
         LOG_ERROR("delete database info failed");
@@ -204,6 +213,34 @@ int32_t DeleteCredentialFunc(CredentialDeleteParam param, CredentialInfoHal *cre
     return ret;
 }
 
+// The credentials are deleted in one transaction, so either all of them are deleted with a single write or none is.
+int32_t DeleteCredentialsFunc(CredentialsDeleteParam param, CredentialInfoHal *credentialInfos)
+{
+    if (param.credentialIds == NULL || credentialInfos == NULL || param.credentialNum == 0 ||
+        param.credentialNum > MAX_CREDENTIAL) {
+        LOG_ERROR("param is invalid");
+        return RESULT_BAD_PARAM;
+    }
+    int32_t ret = CheckDeleteToken(param.token);
+    if (ret != RESULT_SUCCESS) {
+        return ret;
+    }
+    ret = BeginUserInfoTransaction();
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("begin transaction failed");
+        return ret;
+    }
+    for (uint32_t i = 0; i < param.credentialNum; i++) {
+        ret = DeleteCredentialInfo(param.userId, param.credentialIds[i], &credentialInfos[i]);
+        if (ret != RESULT_SUCCESS) {
+            LOG_ERROR("delete database info failed");
+            (void)RollbackUserInfoTransaction();
+            return RESULT_BAD_SIGN;
+        }
+    }
+    return CommitUserInfoTransaction();
+}
+
 int32_t QueryCredentialFunc(int32_t userId, uint32_t authType,
     CredentialInfoHal **credentialInfoArray, uint32_t *credentialNum)
 {
@@ -238,6 +275,26 @@ int32_t QueryCredentialFunc(int32_t userId, uint32_t authType,
     return RESULT_SUCCESS;
 }
 
+int32_t VisitCredentialFunc(int32_t userId, uint32_t authType, CredentialVisitFunc visitor, void *visitorContext)
+{
+    if (visitor == NULL) {
+        LOG_ERROR("visitor is null");
+        return RESULT_BAD_PARAM;
+    }
+    if (authType == DEFAULT_AUTH_TYPE) {
+        return VisitCredentialInfoAll(userId, visitor, visitorContext);
+    }
+    if (userId == ALL_INFO_GET_USER_ID) {
+        return VisitCredentialFromExecutor(authType, visitor, visitorContext);
+    }
+    CredentialInfoHal credentialInfo;
+    int32_t ret = QueryCredentialInfo(userId, authType, &credentialInfo);
+    if (ret != RESULT_SUCCESS) {
+        return ret;
+    }
+    return visitor(&credentialInfo, visitorContext);
+}
+
 int32_t GetUserSecureUidFunc(int32_t userId, uint64_t *secureUid, EnrolledInfoHal **enrolledInfoArray,
     uint32_t *enrolledNum)
 {
@@ -309,17 +366,31 @@ int32_t UpdateCredentialFunc(const uint8_t *enrollToken, uint32_t tokenLen, uint
         LOG_ERROR("query failed");
         return ret;
     }
+    ret = BeginUserInfoTransaction();
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("begin transaction failed");
+        return ret;
+    }
     ret = DeleteCredentialInfo(userId, deletedCredential->credentialId, deletedCredential);
     if (ret != RESULT_SUCCESS) {
         LOG_ERROR("delete failed");
-        return ret;
+        goto FAIL;
     }
 
     CredentialInfoHal credentialInfo;
     GetInfoFromToken(&credentialInfo, token);
     ret = AddCredentialInfo(userId, &credentialInfo);
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("add failed");
+        goto FAIL;
+    }
+    ret = CommitUserInfoTransaction();
     if (ret == RESULT_SUCCESS) {
         *credentialId = credentialInfo.credentialId;
     }
     return ret;
+
+FAIL:
+    (void)RollbackUserInfoTransaction();
+    return ret;
 }
\ No newline at end of file
@@ -53,6 +53,7 @@ typedef struct {
 int32_t GetScheduleInfo(uint64_t scheduleId, ScheduleInfo &scheduleInfo);
 int32_t DeleteScheduleInfo(uint64_t scheduleId, ScheduleInfo &scheduleInfo);
 int32_t GetScheduleToken(std::vector<uint8_t> executorFinishMsg, ScheduleToken &scheduleToken);
+int32_t VerifyScheduleTokens(const std::vector<ScheduleToken> &scheduleTokens, std::vector<int32_t> &results);
 
 int32_t ExecutorRegister(ExecutorInfo executorInfo, uint64_t &executorId);
 int32_t ExecutorUnRegister(uint64_t executorId);
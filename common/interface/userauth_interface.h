@@ -49,6 +49,7 @@ int32_t GenerateSolution(AuthSolution param, std::vector<uint64_t> &scheduleIds)
 int32_t RequestAuthResult(uint64_t contextId, std::vector<uint8_t> &scheduleToken, UserAuthToken &authToken,
     std::vector<uint64_t> &scheduleIds);
 int32_t CancelContext(uint64_t contextId, std::vector<uint64_t> &scheduleIds);
+int32_t VerifyAuthTokens(const std::vector<UserAuthToken> &authTokens, std::vector<int32_t> &results);
 int32_t GetAuthTrustLevel(int32_t userId, uint32_t authType, uint32_t &authTrustLevel);
 } // UserAuth
 } // UserIAM
@@ -16,6 +16,7 @@
 #ifndef USER_IAM_COMMON_INTERFACE
 #define USER_IAM_COMMON_INTERFACE
 
+#include "string"
 #include "vector"
 #include "stdint.h"
 
@@ -25,6 +26,8 @@ namespace Common {
 int32_t Init();
 int32_t Close();
 bool IsIAMInited();
+// Human readable memory statistics of the common lib, only collected when built with useriam_memory_stats.
+void GetMemoryDumpInfo(std::string &info);
 } // Common
 } // UserIAM
 } // OHOS
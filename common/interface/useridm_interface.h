@@ -43,6 +43,8 @@ int32_t InitSchedulation(std::vector<uint8_t> authToken, int32_t userId, uint32_
 int32_t AddCredential(std::vector<uint8_t> enrollToken, uint64_t &credentialId);
 int32_t DeleteCredential(int32_t userId, uint64_t credentialId, std::vector<uint8_t> authToken,
     CredentialInfo &credentialInfo);
+int32_t DeleteCredentials(int32_t userId, const std::vector<uint64_t> &credentialIds, std::vector<uint8_t> authToken,
+    std::vector<CredentialInfo> &credentialInfos);
 int32_t QueryCredential(int32_t userId, uint32_t authType, std::vector<CredentialInfo> &credentialInfos);
 int32_t GetSecureUid(int32_t userId, uint64_t &secureUid, std::vector<EnrolledInfo> &enrolledInfos);
 int32_t DeleteUser(int32_t userId, std::vector<uint8_t> authToken, std::vector<CredentialInfo> &credentialInfos);
@@ -19,7 +19,10 @@
 #include "buffer.h"
 #include "defines.h"
 
-Buffer *GetTokenKey(void);
 ResultCode InitTokenKey(void);
+// Computes the token MAC with the pre-keyed context, writing it straight into the caller's sign field.
+ResultCode TokenHmacSha256(const uint8_t *data, uint32_t dataSize, uint8_t *hmac, uint32_t hmacSize);
+// Checks the token MAC in place without allocating, returns RESULT_BAD_SIGN on mismatch.
+ResultCode TokenHmacSha256Verify(const uint8_t *data, uint32_t dataSize, const uint8_t *hmac, uint32_t hmacSize);
 
 #endif
\ No newline at end of file
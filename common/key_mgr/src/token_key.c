@@ -26,26 +26,62 @@
 
 // This is for example only. Should be implemented in trusted environment.
 static Buffer *g_tokenKey = NULL;
-
-Buffer *GetTokenKey(void)
-{
-    return CopyBuffer(g_tokenKey);
-}
+// Keyed once with g_tokenKey, only used under the global lock.
+static HmacContext *g_tokenHmacContext = NULL;
 
 ResultCode InitTokenKey(void)
 {
-    if (g_tokenKey != NULL) {
+    if (g_tokenKey != NULL && g_tokenHmacContext != NULL) {
         return RESULT_SUCCESS;
     }
-    g_tokenKey = CreateBuffer(SHA256_KEY_LEN);
     if (g_tokenKey == NULL) {
-        LOG_ERROR("g_tokenKey: create buffer failed");
-        return RESULT_NO_MEMORY;
+        g_tokenKey = CreateBuffer(SHA256_KEY_LEN);
+        if (g_tokenKey == NULL) {
+            LOG_ERROR("g_tokenKey: create buffer failed");
+            return RESULT_NO_MEMORY;
+        }
+        if (SecureRandom(g_tokenKey->buf, g_tokenKey->maxSize) != RESULT_SUCCESS) {
+            LOG_ERROR("get random failed");
+            DestoryBuffer(g_tokenKey);
+            g_tokenKey = NULL;
+            return RESULT_GENERAL_ERROR;
+        }
+        g_tokenKey->contentSize = g_tokenKey->maxSize;
+    }
+    g_tokenHmacContext = CreateHmacSha256Context(g_tokenKey);
+    if (g_tokenHmacContext == NULL) {
+        LOG_ERROR("create hmac context failed");
+        return RESULT_GENERAL_ERROR;
+    }
+    return RESULT_SUCCESS;
+}
+
+ResultCode TokenHmacSha256(const uint8_t *data, uint32_t dataSize, uint8_t *hmac, uint32_t hmacSize)
+{
+    if (g_tokenHmacContext == NULL) {
+        LOG_ERROR("token key is not initialized");
+        return RESULT_NEED_INIT;
+    }
+    if (HmacSha256WithContext(g_tokenHmacContext, data, dataSize, hmac, hmacSize) != RESULT_SUCCESS) {
+        LOG_ERROR("token hmac failed");
+        return RESULT_GENERAL_ERROR;
+    }
+    return RESULT_SUCCESS;
+}
+
+ResultCode TokenHmacSha256Verify(const uint8_t *data, uint32_t dataSize, const uint8_t *hmac, uint32_t hmacSize)
+{
+    if (g_tokenHmacContext == NULL) {
+        LOG_ERROR("token key is not initialized");
+        return RESULT_NEED_INIT;
+    }
+    int32_t ret = HmacSha256VerifyWithContext(g_tokenHmacContext, data, dataSize, hmac, hmacSize);
+    if (ret == RESULT_BAD_SIGN) {
+        return RESULT_BAD_SIGN;
     }
-    if (SecureRandom(g_tokenKey->buf, g_tokenKey->maxSize) != RESULT_SUCCESS) {
-        LOG_ERROR("get random failed");
+    if (ret != RESULT_SUCCESS) {
+        LOG_ERROR("token hmac failed");
         return RESULT_GENERAL_ERROR;
     }
-    g_tokenKey->contentSize = g_tokenKey->maxSize;
     return RESULT_SUCCESS;
 }
\ No newline at end of file
@@ -16,7 +16,10 @@
 #ifndef USER_IAM_LOCK
 #define USER_IAM_LOCK
 
+#include <stdbool.h>
+
 void GlobalLock(void);
+bool GlobalTryLock(void);
 void GlobalUnLock(void);
 
 #endif
\ No newline at end of file
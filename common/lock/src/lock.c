@@ -24,6 +24,11 @@ void GlobalLock(void)
     (void)pthread_mutex_lock(&g_mutex);
 }
 
+bool GlobalTryLock(void)
+{
+    return pthread_mutex_trylock(&g_mutex) == 0;
+}
+
 void GlobalUnLock(void)
 {
     (void)pthread_mutex_unlock(&g_mutex);
@@ -27,6 +27,7 @@
 #define AUTH_TOKEN_DATA_LEN (AUTH_TOKEN_LEN - SHA256_SIGN_LEN)
 #define SHA256_KEY_LEN 32
 #define TOKEN_VERSION 0
+#define MAX_VERIFY_TOKEN_NUM 64
 
 typedef struct {
     int32_t authResult;
@@ -43,5 +44,8 @@ typedef struct {
 
 ResultCode UserAuthTokenSign(UserAuthTokenHal *userAuthToken);
 ResultCode UserAuthTokenVerify(const UserAuthTokenHal *userAuthToken);
+// Verifies tokenNum tokens in one pass, results[i] receives the result of tokens[i].
+// Returns RESULT_SUCCESS only if every token is valid, otherwise the first failure.
+ResultCode UserAuthTokenVerifyBatch(const UserAuthTokenHal *userAuthTokens, uint32_t tokenNum, ResultCode *results);
 
 #endif // USERIAM_USER_SIGN_CENTRE_H
\ No newline at end of file
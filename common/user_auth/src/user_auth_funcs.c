@@ -18,6 +18,7 @@
 #include "securec.h"
 
 #include "adaptor_log.h"
+#include "adaptor_memory.h"
 #include "adaptor_time.h"
 #include "coauth_sign_centre.h"
 #include "context_manager.h"
@@ -65,42 +66,85 @@ static int32_t GetTokenDataAndSign(UserAuthContext *context, UserAuthTokenHal *a
     return UserAuthTokenSign(authToken);
 }
 
-int32_t RequestAuthResultFunc(uint64_t contextId, const Buffer *scheduleToken, UserAuthTokenHal *authToken,
-    uint64_t **scheduleIdArray, uint32_t *scheduleNum)
+// The tokens of the schedules of a context come one after another and are verified in one batch.
+static int32_t GetVerifiedScheduleTokens(const Buffer *scheduleToken, ScheduleTokenHal **scheduleTokens,
+    uint32_t *tokenNum)
 {
-    if (scheduleToken == NULL || authToken == NULL || scheduleIdArray == NULL || scheduleNum == NULL) {
-        LOG_ERROR("param is null");
+    if (!IsBufferValid(scheduleToken) || scheduleToken->contentSize == 0 ||
+        scheduleToken->contentSize % sizeof(ScheduleTokenHal) != 0 ||
+        scheduleToken->contentSize / sizeof(ScheduleTokenHal) > MAX_VERIFY_TOKEN_NUM) {
+        LOG_ERROR("scheduleToken is invalid");
         return RESULT_BAD_PARAM;
     }
-    ScheduleTokenHal scheduleTokenStruct;
-    if (memcpy_s(&scheduleTokenStruct, sizeof(ScheduleTokenHal), scheduleToken->buf,
+    *tokenNum = scheduleToken->contentSize / sizeof(ScheduleTokenHal);
+    *scheduleTokens = ArenaMalloc(scheduleToken->contentSize);
+    ResultCode *results = ArenaMalloc(*tokenNum * sizeof(ResultCode));
+    if (*scheduleTokens == NULL || results == NULL) {
+        LOG_ERROR("malloc failed");
+        Free(*scheduleTokens);
+        *scheduleTokens = NULL;
+        Free(results);
+        return RESULT_NO_MEMORY;
+    }
+    if (memcpy_s(*scheduleTokens, scheduleToken->contentSize, scheduleToken->buf,
         scheduleToken->contentSize) != EOK) {
-        LOG_ERROR("scheduleTokenStruct copy failed");
+        LOG_ERROR("scheduleTokens copy failed");
+        Free(*scheduleTokens);
+        *scheduleTokens = NULL;
+        Free(results);
         return RESULT_BAD_COPY;
     }
-    int32_t ret = CoAuthTokenVerify(&scheduleTokenStruct);
+    ResultCode ret = CoAuthTokenVerifyBatch(*scheduleTokens, *tokenNum, results);
+    Free(results);
     if (ret != RESULT_SUCCESS) {
         LOG_ERROR("verify token failed");
+        Free(*scheduleTokens);
+        *scheduleTokens = NULL;
         return RESULT_BAD_SIGN;
     }
+    return RESULT_SUCCESS;
+}
+
+int32_t RequestAuthResultFunc(uint64_t contextId, const Buffer *scheduleToken, UserAuthTokenHal *authToken,
+    uint64_t **scheduleIdArray, uint32_t *scheduleNum)
+{
+    if (scheduleToken == NULL || authToken == NULL || scheduleIdArray == NULL || scheduleNum == NULL) {
+        LOG_ERROR("param is null");
+        return RESULT_BAD_PARAM;
+    }
+    ScheduleTokenHal *scheduleTokens = NULL;
+    uint32_t tokenNum = 0;
+    int32_t ret = GetVerifiedScheduleTokens(scheduleToken, &scheduleTokens, &tokenNum);
+    if (ret != RESULT_SUCCESS) {
+        return ret;
+    }
 
     UserAuthContext *userAuthContext = GetContext(contextId);
     if (userAuthContext == NULL) {
         LOG_ERROR("userAuthContext is null");
+        Free(scheduleTokens);
         return RESULT_UNKNOWN;
     }
-    ret = ScheduleOnceFinish(userAuthContext, scheduleTokenStruct.scheduleId);
-    if (ret != RESULT_SUCCESS) {
-        DestoryContext(userAuthContext);
-        return ret;
+    uint32_t scheduleResult = RESULT_SUCCESS;
+    for (uint32_t i = 0; i < tokenNum; i++) {
+        ret = ScheduleOnceFinish(userAuthContext, scheduleTokens[i].scheduleId);
+        if (ret != RESULT_SUCCESS) {
+            DestoryContext(userAuthContext);
+            Free(scheduleTokens);
+            return ret;
+        }
+        if (scheduleResult == RESULT_SUCCESS) {
+            scheduleResult = scheduleTokens[i].scheduleResult;
+        }
     }
+    Free(scheduleTokens);
     ret = GetScheduleIds(userAuthContext, scheduleIdArray, scheduleNum);
     if (ret != RESULT_SUCCESS) {
         DestoryContext(userAuthContext);
         return ret;
     }
 
-    if (scheduleTokenStruct.scheduleResult == RESULT_SUCCESS) {
+    if (scheduleResult == RESULT_SUCCESS) {
         ret = GetTokenDataAndSign(userAuthContext, authToken);
         if (ret != RESULT_SUCCESS) {
             LOG_ERROR("sign token failed");
@@ -110,7 +154,7 @@ int32_t RequestAuthResultFunc(uint64_t contextId, const Buffer *scheduleToken, U
             (void)memset_s(authToken, sizeof(UserAuthTokenHal), 0, sizeof(UserAuthTokenHal));
         }
     } else {
-        authToken->authResult = scheduleTokenStruct.scheduleResult;
+        authToken->authResult = scheduleResult;
     }
     DestoryContext(userAuthContext);
     return ret;
@@ -31,6 +31,7 @@ public:
 
     virtual void OnFinish(uint32_t resultCode, std::vector<uint8_t> &scheduleToken) override;
     virtual void OnAcquireInfo(uint32_t acquire) override;
+    virtual void OnAcquireExtraInfo(uint32_t acquire, std::vector<uint8_t> &extraInfo) override;
 private:
     bool SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply);
 
@@ -30,12 +30,14 @@ public:
 
     virtual void OnFinish(uint32_t resultCode, std::vector<uint8_t> &scheduleToken) override;
     virtual void OnAcquireInfo(uint32_t acquire) override;
+    virtual void OnAcquireExtraInfo(uint32_t acquire, std::vector<uint8_t> &extraInfo) override;
 
     int32_t OnRemoteRequest(
         uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override;
 private:
     int32_t OnFinishStub(MessageParcel &data, MessageParcel &reply);
     int32_t OnAcquireInfoStub(MessageParcel &data, MessageParcel &reply);
+    int32_t OnAcquireExtraInfoStub(MessageParcel &data, MessageParcel &reply);
 
     std::shared_ptr<CoAuthCallback> callback_;
 };
@@ -34,12 +34,20 @@ public:
                               const sptr<AuthResPool::IExecutorCallback> &callback) override;
     virtual void QueryStatus(AuthResPool::AuthExecutor &executorInfo,
                              const sptr<AuthResPool::IQueryCallback> &callback) override;
+    virtual int32_t RegisterMany(std::vector<std::shared_ptr<AuthResPool::AuthExecutor>> &executorInfos,
+                                 std::vector<sptr<AuthResPool::IExecutorCallback>> &callbacks,
+                                 std::vector<uint64_t> &executorIds) override;
     virtual void BeginSchedule(uint64_t scheduleId, AuthInfo &authInfo, const sptr<ICoAuthCallback> &callback) override;
     virtual int32_t Cancel(uint64_t scheduleId) override;
     virtual int32_t GetExecutorProp(AuthResPool::AuthAttributes &conditions,
                                     std::shared_ptr<AuthResPool::AuthAttributes> values) override;
     virtual void SetExecutorProp(AuthResPool::AuthAttributes &conditions,
                                  const sptr<ISetPropCallback> &callback) override;
+    virtual int32_t GetExecutorProps(std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &conditions,
+                                     std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &values,
+                                     std::vector<int32_t> &results) override;
+    virtual int32_t SetExecutorProps(std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &conditions,
+                                     std::vector<int32_t> &results) override;
 
 private:
     bool SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, bool isSync = true);
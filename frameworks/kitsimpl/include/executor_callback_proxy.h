@@ -33,11 +33,18 @@ public:
     virtual int32_t OnBeginExecute(uint64_t scheduleId, std::vector<uint8_t> &publicKey,
                                    std::shared_ptr<AuthAttributes> commandAttrs) override;
     virtual int32_t OnEndExecute(uint64_t scheduleId, std::shared_ptr<AuthAttributes> consumerAttr) override;
+    virtual void OnCancelExecute(uint64_t scheduleId, std::shared_ptr<AuthAttributes> consumerAttr) override;
     virtual int32_t OnSetProperty(std::shared_ptr<AuthAttributes> properties)  override;
     virtual int32_t OnGetProperty(std::shared_ptr<AuthAttributes> conditions,
                                   std::shared_ptr<AuthAttributes> values) override;
+    virtual int32_t OnGetProperties(std::vector<std::shared_ptr<AuthAttributes>> &conditions,
+                                    std::vector<std::shared_ptr<AuthAttributes>> &values,
+                                    std::vector<int32_t> &results) override;
+    virtual int32_t OnSetProperties(std::vector<std::shared_ptr<AuthAttributes>> &properties,
+                                    std::vector<int32_t> &results) override;
 private:
-    bool SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply);
+    bool SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, bool isSync = true);
+    int32_t SendSyncRequest(uint32_t code, MessageParcel &data, MessageParcel &reply);
     static inline BrokerDelegator<ExecutorCallbackProxy> delegator_;
 };
 } // namespace AuthResPool
@@ -31,9 +31,15 @@ public:
     virtual int32_t OnBeginExecute(uint64_t scheduleId, std::vector<uint8_t> &publicKey,
                                    std::shared_ptr<AuthAttributes> commandAttrs) override;
     virtual int32_t OnEndExecute(uint64_t scheduleId, std::shared_ptr<AuthAttributes> consumerAttr) override;
+    virtual void OnCancelExecute(uint64_t scheduleId, std::shared_ptr<AuthAttributes> consumerAttr) override;
     virtual int32_t OnSetProperty(std::shared_ptr<AuthAttributes> properties)  override;
     virtual int32_t OnGetProperty(std::shared_ptr<AuthAttributes> conditions,
                                   std::shared_ptr<AuthAttributes> values) override;
+    virtual int32_t OnGetProperties(std::vector<std::shared_ptr<AuthAttributes>> &conditions,
+                                    std::vector<std::shared_ptr<AuthAttributes>> &values,
+                                    std::vector<int32_t> &results) override;
+    virtual int32_t OnSetProperties(std::vector<std::shared_ptr<AuthAttributes>> &properties,
+                                    std::vector<int32_t> &results) override;
     int OnRemoteRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override;
 private:
     int32_t OnMessengerReadyStub(MessageParcel& data, MessageParcel& reply);
@@ -41,6 +47,8 @@ private:
     int32_t OnEndExecuteStub(MessageParcel& data, MessageParcel& reply);
     int32_t OnGetPropertyStub(MessageParcel& data, MessageParcel& reply);
     int32_t OnSetPropertyStub(MessageParcel& data, MessageParcel& reply);
+    int32_t OnGetPropertiesStub(MessageParcel& data, MessageParcel& reply);
+    int32_t OnSetPropertiesStub(MessageParcel& data, MessageParcel& reply);
     std::shared_ptr<ExecutorCallback> callback_;
 };
 } // namespace AuthResPool
@@ -39,7 +39,10 @@ public:
         COAUTH_SCHEDULE_REQUEST,
         COAUTH_SCHEDULE_CANCEL,
         COAUTH_GET_PROPERTY,
-        COAUTH_SET_PROPERTY
+        COAUTH_SET_PROPERTY,
+        COAUTH_GET_PROPERTIES,
+        COAUTH_SET_PROPERTIES,
+        COAUTH_EXECUTOR_REGIST_MANY
     };
 
     /* Business function */
@@ -47,11 +50,21 @@ public:
                               const sptr<AuthResPool::IExecutorCallback> &callback) = 0;
     virtual void QueryStatus(AuthResPool::AuthExecutor &executorInfo,
                              const sptr<AuthResPool::IQueryCallback> &callback) = 0;
+    /* Registers several executors in one request, executorIds follow the order of executorInfos */
+    virtual int32_t RegisterMany(std::vector<std::shared_ptr<AuthResPool::AuthExecutor>> &executorInfos,
+                                 std::vector<sptr<AuthResPool::IExecutorCallback>> &callbacks,
+                                 std::vector<uint64_t> &executorIds) = 0;
     virtual void BeginSchedule(uint64_t scheduleId, AuthInfo &authInfo, const sptr<ICoAuthCallback> &callback) = 0;
     virtual int32_t Cancel(uint64_t scheduleId) = 0;
     virtual int32_t GetExecutorProp(AuthResPool::AuthAttributes &conditions,
                                     std::shared_ptr<AuthResPool::AuthAttributes> values) = 0;
     virtual void SetExecutorProp(AuthResPool::AuthAttributes &conditions, const sptr<ISetPropCallback> &callback) = 0;
+    /* Batched variants, results and values follow the order of conditions */
+    virtual int32_t GetExecutorProps(std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &conditions,
+                                     std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &values,
+                                     std::vector<int32_t> &results) = 0;
+    virtual int32_t SetExecutorProps(std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &conditions,
+                                     std::vector<int32_t> &results) = 0;
 
     DECLARE_INTERFACE_DESCRIPTOR(u"ohos.CoAuth.ICoAuth");
 };
@@ -29,11 +29,13 @@ public:
 
     enum {
         ONFINISH = 0,
-        ONACQUIREINFO
+        ONACQUIREINFO,
+        ONACQUIREEXTRAINFO
     };
 
     virtual void OnFinish(uint32_t resultCode, std::vector<uint8_t> &scheduleToken) = 0;
     virtual void OnAcquireInfo(uint32_t acquire) = 0;
+    virtual void OnAcquireExtraInfo(uint32_t acquire, std::vector<uint8_t> &extraInfo) = 0;
 
     DECLARE_INTERFACE_DESCRIPTOR(u"ohos.CoAuth.ICoAuthCallback");
 };
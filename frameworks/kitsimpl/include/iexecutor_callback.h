@@ -29,18 +29,31 @@ public:
     virtual int32_t OnBeginExecute(uint64_t scheduleId, std::vector<uint8_t> &publicKey,
                                    std::shared_ptr<AuthAttributes> commandAttrs) = 0;
     virtual int32_t OnEndExecute(uint64_t scheduleId, std::shared_ptr<AuthAttributes> consumerAttr) = 0;
+    /* One-way OnEndExecute, used to cancel a schedule without waiting for the executor */
+    virtual void OnCancelExecute(uint64_t scheduleId, std::shared_ptr<AuthAttributes> consumerAttr) = 0;
     virtual int32_t OnSetProperty(std::shared_ptr<AuthAttributes> properties)  = 0;
     virtual int32_t OnGetProperty(std::shared_ptr<AuthAttributes> conditions,
                                   std::shared_ptr<AuthAttributes> values) = 0;
+    /* Batched variants, results and values follow the order of conditions */
+    virtual int32_t OnGetProperties(std::vector<std::shared_ptr<AuthAttributes>> &conditions,
+                                    std::vector<std::shared_ptr<AuthAttributes>> &values,
+                                    std::vector<int32_t> &results) = 0;
+    virtual int32_t OnSetProperties(std::vector<std::shared_ptr<AuthAttributes>> &properties,
+                                    std::vector<int32_t> &results) = 0;
 
     DECLARE_INTERFACE_DESCRIPTOR(u"ohos.UserIAM.AuthResPool.ExecutorCallback");
 
+    /* Returned by the batched variants when the executor predates them and rejects their message codes */
+    static constexpr int32_t BATCH_NOT_SUPPORT = -1;
+
     enum Message {
         ON_MESSENGER_READY = 1,
         ON_BEGIN_EXECUTE,
         ON_END_EXECUTE,
         ON_SET_PROPERTY,
-        ON_GET_PROPERTY
+        ON_GET_PROPERTY,
+        ON_GET_PROPERTIES,
+        ON_SET_PROPERTIES
     };
 };
 } // namespace AuthResPool
@@ -14,19 +14,151 @@
  */
 
 #include "auth_executor_registry.h"
+#include <algorithm>
 #include <if_system_ability_manager.h>
 #include <iservice_registry.h>
 #include <system_ability_definition.h>
+#include <system_ability_status_change_stub.h>
 #include "query_callback_stub.h"
 #include "executor_callback_stub.h"
 
 namespace OHOS {
 namespace UserIAM {
 namespace AuthResPool {
-AuthExecutorRegistry::AuthExecutorRegistry() = default;
+namespace {
+class AuthExecutorRegistryStatusListener : public SystemAbilityStatusChangeStub {
+public:
+    void OnAddSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override
+    {
+        (void)deviceId;
+        if (systemAbilityId == SUBSYS_USERIAM_SYS_ABILITY_AUTHEXECUTORMGR) {
+            AuthExecutorRegistry::GetInstance().PreConnect();
+        }
+    }
+
+    void OnRemoveSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override
+    {
+        (void)systemAbilityId;
+        (void)deviceId;
+    }
+};
+
+} // namespace
+
+// Subscribed once when the instance is created, so the listener connects whenever the service comes up, also when
+// it was not up yet at the first call.
+AuthExecutorRegistry::AuthExecutorRegistry()
+{
+    statusListener_ = new AuthExecutorRegistryStatusListener();
+    SubscribeServiceStatus();
+}
+
 AuthExecutorRegistry::~AuthExecutorRegistry() = default;
 
+void AuthExecutorRegistry::PreConnect()
+{
+    if (GetProxy() == nullptr) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "pre connect coauth service failed");
+        return;
+    }
+    ReRegister();
+}
+
+// No lock is held while the executors are sent, the service calls each executor back before it replies.
+void AuthExecutorRegistry::ReRegister()
+{
+    std::vector<RegisteredExecutor> executors;
+    {
+        std::lock_guard<std::mutex> lock(executorsMutex_);
+        for (auto &executor : executors_) {
+            if (!executor.registered && !executor.registering) {
+                executor.registering = true;
+                executor.attempt++;
+                executors.push_back(executor);
+            }
+        }
+    }
+    if (executors.empty()) {
+        return;
+    }
+    std::vector<RegisteredExecutor> changed;
+    SendReRegister(executors, changed);
+    // An executor may register again from its callback.
+    for (auto &executor : changed) {
+        executor.callback->OnExecutorIdChanged(executor.executorId);
+    }
+}
+
+void AuthExecutorRegistry::SendReRegister(std::vector<RegisteredExecutor> &executors,
+    std::vector<RegisteredExecutor> &changed)
+{
+    auto proxy = GetProxy();
+    if (proxy == nullptr) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "proxy is nullptr");
+    } else {
+        COAUTH_HILOGI(MODULE_INNERKIT, "register %{public}zu executors again", executors.size());
+    }
+    std::size_t begin = 0;
+    for (; proxy != nullptr && begin < executors.size(); begin += MAX_REGISTER_BATCH_NUM) {
+        std::size_t end = std::min(executors.size(), begin + MAX_REGISTER_BATCH_NUM);
+        std::vector<std::shared_ptr<AuthExecutor>> executorInfos;
+        std::vector<sptr<IExecutorCallback>> stubs;
+        for (std::size_t i = begin; i < end; i++) {
+            executorInfos.push_back(executors[i].executorInfo);
+            stubs.push_back(executors[i].stub);
+        }
+        std::vector<uint64_t> executorIds;
+        if (proxy->RegisterMany(executorInfos, stubs, executorIds) != SUCCESS || executorIds.size() != end - begin) {
+            COAUTH_HILOGE(MODULE_INNERKIT, "register executors again failed");
+            break;
+        }
+        for (std::size_t i = begin; i < end; i++) {
+            executors[i].executorId = executorIds[i - begin];
+            if (FinishRegister(executors[i].callback, executors[i].attempt, executors[i].executorId, false)) {
+                changed.push_back(executors[i]);
+            }
+        }
+    }
+    // Not sent, they are tried again when the service comes up next.
+    for (std::size_t i = begin; i < executors.size(); i++) {
+        (void)FinishRegister(executors[i].callback, executors[i].attempt, INVALID_EXECUTOR_ID, false);
+    }
+}
+
+// Takes the result of a registration sent without the locks, unless the executor was unregistered, registered
+// by another attempt or lost with the service meanwhile.
+bool AuthExecutorRegistry::FinishRegister(const std::shared_ptr<ExecutorCallback> &callback, uint32_t attempt,
+    uint64_t executorId, bool forgetOnFailure)
+{
+    std::lock_guard<std::mutex> lock(executorsMutex_);
+    auto iter = std::find_if(executors_.begin(), executors_.end(),
+        [&callback](const RegisteredExecutor &executor) { return executor.callback == callback; });
+    if (iter == executors_.end() || !iter->registering || iter->attempt != attempt) {
+        return false;
+    }
+    iter->registering = false;
+    if (executorId == INVALID_EXECUTOR_ID) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "register executor failed");
+        if (forgetOnFailure) {
+            executors_.erase(iter);
+        }
+        return false;
+    }
+    iter->executorId = executorId;
+    iter->registered = true;
+    return true;
+}
+
 sptr<CoAuth::ICoAuth> AuthExecutorRegistry::GetProxy()
+{
+    std::shared_ptr<const sptr<CoAuth::ICoAuth>> published = std::atomic_load(&publishedProxy_);
+    if (published != nullptr) {
+        return *published;
+    }
+    return Connect();
+}
+
+sptr<CoAuth::ICoAuth> AuthExecutorRegistry::Connect()
 {
     std::lock_guard<std::mutex> lock(mutex_);
     if (proxy_ != nullptr) {
@@ -51,10 +183,23 @@ sptr<CoAuth::ICoAuth> AuthExecutorRegistry::GetProxy()
 
     proxy_ = iface_cast<CoAuth::ICoAuth>(obj);
     deathRecipient_ = dr;
+    std::atomic_store(&publishedProxy_, std::make_shared<const sptr<CoAuth::ICoAuth>>(proxy_));
     COAUTH_HILOGI(MODULE_INNERKIT, "connect coauth service success");
     return proxy_;
 }
 
+void AuthExecutorRegistry::SubscribeServiceStatus()
+{
+    sptr<ISystemAbilityManager> sam = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    if (sam == nullptr) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "get system ability manager failed");
+        return;
+    }
+    if (sam->SubscribeSystemAbility(SUBSYS_USERIAM_SYS_ABILITY_AUTHEXECUTORMGR, statusListener_) != ERR_OK) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "subscribe coauth service failed");
+    }
+}
+
 void AuthExecutorRegistry::ResetProxy(const wptr<IRemoteObject>& remote)
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -64,7 +209,15 @@ void AuthExecutorRegistry::ResetProxy(const wptr<IRemoteObject>& remote)
     auto serviceRemote = proxy_->AsObject();
     if ((serviceRemote != nullptr) && (serviceRemote == remote.promote())) {
         serviceRemote->RemoveDeathRecipient(deathRecipient_);
+        std::atomic_store(&publishedProxy_, std::shared_ptr<const sptr<CoAuth::ICoAuth>>(nullptr));
         proxy_ = nullptr;
+        // The registrations died with the service, the status listener registers them again.
+        std::lock_guard<std::mutex> executorsLock(executorsMutex_);
+        for (auto &executor : executors_) {
+            executor.registered = false;
+            // A registration being sent went to the dead service, its result is dropped.
+            executor.registering = false;
+        }
     }
 }
 
@@ -81,8 +234,50 @@ uint64_t AuthExecutorRegistry::Register(std::shared_ptr<AuthExecutor> executorIn
         COAUTH_HILOGE(MODULE_INNERKIT, "proxy is nullptr");
         return FAIL;
     }
-    sptr<IExecutorCallback> iExecutorCallback = new ExecutorCallbackStub(callback);
-    return proxy->Register(executorInfo, iExecutorCallback);
+    sptr<IExecutorCallback> iExecutorCallback = nullptr;
+    uint32_t attempt = 0;
+    bool isNew = false;
+    {
+        std::lock_guard<std::mutex> lock(executorsMutex_);
+        auto iter = std::find_if(executors_.begin(), executors_.end(),
+            [&callback](const RegisteredExecutor &executor) { return executor.callback == callback; });
+        if (iter != executors_.end() && iter->registered) {
+            COAUTH_HILOGI(MODULE_INNERKIT, "executor is registered");
+            return iter->executorId;
+        }
+        if (iter != executors_.end() && iter->registering) {
+            COAUTH_HILOGE(MODULE_INNERKIT, "executor is being registered");
+            return INVALID_EXECUTOR_ID;
+        }
+        if (iter == executors_.end()) {
+            isNew = true;
+            executors_.push_back({ executorInfo, callback, new ExecutorCallbackStub(callback), INVALID_EXECUTOR_ID,
+                false, false, 0 });
+            iter = executors_.end() - 1;
+        }
+        // Lost with the service and not registered again yet, the executor keeps its binder object.
+        iter->executorInfo = executorInfo;
+        iter->registering = true;
+        attempt = ++iter->attempt;
+        iExecutorCallback = iter->stub;
+    }
+    // Sent without the locks, the service calls OnMessengerReady back before it replies.
+    uint64_t executorId = proxy->Register(executorInfo, iExecutorCallback);
+    (void)FinishRegister(callback, attempt, executorId, isNew);
+    return executorId;
+}
+
+int32_t AuthExecutorRegistry::Unregister(std::shared_ptr<ExecutorCallback> callback)
+{
+    std::lock_guard<std::mutex> lock(executorsMutex_);
+    auto iter = std::find_if(executors_.begin(), executors_.end(),
+        [&callback](const RegisteredExecutor &executor) { return executor.callback == callback; });
+    if (iter == executors_.end()) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "executor is not registered");
+        return FAIL;
+    }
+    executors_.erase(iter);
+    return SUCCESS;
 }
 
 void AuthExecutorRegistry::QueryStatus(AuthExecutor &executorInfo, std::shared_ptr<QueryCallback> callback)
@@ -110,6 +305,8 @@ void AuthExecutorRegistry::AuthExecutorRegistryDeathRecipient::OnRemoteDied(cons
 
     AuthExecutorRegistry::GetInstance().ResetProxy(remote);
     COAUTH_HILOGE(MODULE_INNERKIT, "AuthExecutorRegistryDeathRecipient::Recv death notice");
+    // The service may already be back if its add notice came first, otherwise the status listener does this.
+    AuthExecutorRegistry::GetInstance().ReRegister();
 }
 } // namespace AuthResPool
 } // namespace UserIAM
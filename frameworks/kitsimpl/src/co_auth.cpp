@@ -17,6 +17,7 @@
 #include <if_system_ability_manager.h>
 #include <iservice_registry.h>
 #include <system_ability_definition.h>
+#include <system_ability_status_change_stub.h>
 #include "coauth_hilog_wrapper.h"
 #include "coauth_callback_stub.h"
 #include "set_prop_callback_stub.h"
@@ -24,10 +25,53 @@
 namespace OHOS {
 namespace UserIAM {
 namespace CoAuth {
-CoAuth::CoAuth() = default;
+namespace {
+class CoAuthStatusListener : public SystemAbilityStatusChangeStub {
+public:
+    void OnAddSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override
+    {
+        (void)deviceId;
+        if (systemAbilityId == SUBSYS_USERIAM_SYS_ABILITY_AUTHEXECUTORMGR) {
+            CoAuth::GetInstance().PreConnect();
+        }
+    }
+
+    void OnRemoveSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override
+    {
+        (void)systemAbilityId;
+        (void)deviceId;
+    }
+};
+
+} // namespace
+
+// Subscribed once when the instance is created, so the listener connects whenever the service comes up, also when
+// it was not up yet at the first call.
+CoAuth::CoAuth()
+{
+    statusListener_ = new CoAuthStatusListener();
+    SubscribeServiceStatus();
+}
+
 CoAuth::~CoAuth() = default;
 
+void CoAuth::PreConnect()
+{
+    if (GetProxy() == nullptr) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "pre connect coauth manager service failed");
+    }
+}
+
 sptr<ICoAuth> CoAuth::GetProxy()
+{
+    std::shared_ptr<const sptr<ICoAuth>> published = std::atomic_load(&publishedProxy_);
+    if (published != nullptr) {
+        return *published;
+    }
+    return Connect();
+}
+
+sptr<ICoAuth> CoAuth::Connect()
 {
     std::lock_guard<std::mutex> lock(mutex_);
     if (proxy_ != nullptr) {
@@ -52,10 +96,23 @@ sptr<ICoAuth> CoAuth::GetProxy()
 
     proxy_ = iface_cast<ICoAuth>(obj);
     deathRecipient_ = dr;
+    std::atomic_store(&publishedProxy_, std::make_shared<const sptr<ICoAuth>>(proxy_));
     COAUTH_HILOGD(MODULE_INNERKIT, "connect coauth manager service success");
     return proxy_;
 }
 
+void CoAuth::SubscribeServiceStatus()
+{
+    sptr<ISystemAbilityManager> sam = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    if (sam == nullptr) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "get system ability manager failed");
+        return;
+    }
+    if (sam->SubscribeSystemAbility(SUBSYS_USERIAM_SYS_ABILITY_AUTHEXECUTORMGR, statusListener_) != ERR_OK) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "subscribe coauth manager service failed");
+    }
+}
+
 void CoAuth::ResetProxy(const wptr<IRemoteObject>& remote)
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -66,6 +123,7 @@ void CoAuth::ResetProxy(const wptr<IRemoteObject>& remote)
     auto serviceRemote = proxy_->AsObject();
     if ((serviceRemote != nullptr) && (serviceRemote == remote.promote())) {
         serviceRemote->RemoveDeathRecipient(deathRecipient_);
+        std::atomic_store(&publishedProxy_, std::shared_ptr<const sptr<ICoAuth>>(nullptr));
         proxy_ = nullptr;
     }
 }
@@ -129,6 +187,32 @@ void CoAuth::SetExecutorProp(AuthResPool::AuthAttributes &conditions, std::share
     return proxy->SetExecutorProp(conditions, iSetExecutorCallback);
 }
 
+int32_t CoAuth::GetExecutorProps(std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &conditions,
+                                 std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &values,
+                                 std::vector<int32_t> &results)
+{
+    COAUTH_HILOGD(MODULE_INNERKIT, "CoAuth: GetExecutorProps start");
+    auto proxy = GetProxy();
+    if (proxy == nullptr || conditions.size() > MAX_PROPERTY_BATCH_NUM) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "GetExecutorProps failed, proxy is nullptr or too many conditions");
+        return FAIL;
+    }
+
+    return proxy->GetExecutorProps(conditions, values, results);
+}
+
+int32_t CoAuth::SetExecutorProps(std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &conditions,
+                                 std::vector<int32_t> &results)
+{
+    COAUTH_HILOGD(MODULE_INNERKIT, "CoAuth: SetExecutorProps start");
+    auto proxy = GetProxy();
+    if (proxy == nullptr || conditions.size() > MAX_PROPERTY_BATCH_NUM) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "SetExecutorProps failed, proxy is nullptr or too many conditions");
+        return FAIL;
+    }
+
+    return proxy->SetExecutorProps(conditions, results);
+}
 
 void CoAuth::CoAuthDeathRecipient::OnRemoteDied(const wptr<IRemoteObject>& remote)
 {
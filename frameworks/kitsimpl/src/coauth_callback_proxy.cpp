@@ -60,12 +60,36 @@ void CoAuthCallbackProxy::OnAcquireInfo(uint32_t acquire)
     }
 
     MessageParcel reply;
+    // Sync like OnFinish, so that a tip can never reach the caller after the result.
     bool ret = SendRequest(static_cast<int32_t>(ICoAuthCallback::ONACQUIREINFO), data, reply);
     if (ret) {
         COAUTH_HILOGI(MODULE_INNERKIT, "result = %{public}d", ret);
     }
 }
 
+void CoAuthCallbackProxy::OnAcquireExtraInfo(uint32_t acquire, std::vector<uint8_t> &extraInfo)
+{
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(CoAuthCallbackProxy::GetDescriptor())) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write descriptor failed");
+        return;
+    }
+    if (!data.WriteUint32(acquire)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write acquire failed");
+        return;
+    }
+    if (!data.WriteUInt8Vector(extraInfo)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write extraInfo failed");
+        return;
+    }
+
+    MessageParcel reply;
+    bool ret = SendRequest(static_cast<int32_t>(ICoAuthCallback::ONACQUIREEXTRAINFO), data, reply);
+    if (ret) {
+        COAUTH_HILOGI(MODULE_INNERKIT, "result = %{public}d", ret);
+    }
+}
+
 bool CoAuthCallbackProxy::SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply)
 {
     sptr<IRemoteObject> remote = Remote();
@@ -40,6 +40,8 @@ int32_t CoAuthCallbackStub::OnRemoteRequest(uint32_t code, MessageParcel &data,
             return OnFinishStub(data, reply);
         case static_cast<int32_t>(ICoAuthCallback::ONACQUIREINFO):
             return OnAcquireInfoStub(data, reply);
+        case static_cast<int32_t>(ICoAuthCallback::ONACQUIREEXTRAINFO):
+            return OnAcquireExtraInfoStub(data, reply);
         default:
             return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
     }
@@ -63,6 +65,16 @@ int32_t CoAuthCallbackStub::OnAcquireInfoStub(MessageParcel &data, MessageParcel
     return SUCCESS;
 }
 
+int32_t CoAuthCallbackStub::OnAcquireExtraInfoStub(MessageParcel &data, MessageParcel &reply)
+{
+    (void)reply;
+    uint32_t acquire = data.ReadUint32();
+    std::vector<uint8_t> extraInfo;
+    data.ReadUInt8Vector(&extraInfo);
+    OnAcquireExtraInfo(acquire, extraInfo);
+    return SUCCESS;
+}
+
 void CoAuthCallbackStub::OnFinish(uint32_t resultCode, std::vector<uint8_t> &scheduleToken)
 {
     if (callback_ == nullptr) {
@@ -80,6 +92,15 @@ void CoAuthCallbackStub::OnAcquireInfo(uint32_t acquire)
         callback_->OnAcquireInfo(acquire);
     }
 }
+
+void CoAuthCallbackStub::OnAcquireExtraInfo(uint32_t acquire, std::vector<uint8_t> &extraInfo)
+{
+    if (callback_ == nullptr) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "callback_ is null");
+    } else {
+        callback_->OnAcquireExtraInfo(acquire, extraInfo);
+    }
+}
 } // namespace CoAuth
 } // namespace UserIAM
 } // namespace OHOS
\ No newline at end of file
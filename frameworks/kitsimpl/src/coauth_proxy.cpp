@@ -101,6 +101,55 @@ uint64_t CoAuthProxy::Register(std::shared_ptr<AuthResPool::AuthExecutor> execut
     return result;
 }
 
+int32_t CoAuthProxy::RegisterMany(std::vector<std::shared_ptr<AuthResPool::AuthExecutor>> &executorInfos,
+    std::vector<sptr<AuthResPool::IExecutorCallback>> &callbacks, std::vector<uint64_t> &executorIds)
+{
+    COAUTH_HILOGD(MODULE_INNERKIT, "RegisterMany start");
+    if (executorInfos.size() != callbacks.size() || executorInfos.size() > MAX_REGISTER_BATCH_NUM) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "executorInfos and callbacks do not match");
+        return INVALID_PARAMETERS;
+    }
+    MessageParcel data;
+    MessageParcel reply;
+    if (!data.WriteInterfaceToken(CoAuthProxy::GetDescriptor())) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write descriptor failed");
+        return FAIL;
+    }
+    if (!data.WriteUint32(static_cast<uint32_t>(executorInfos.size()))) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write executor num failed");
+        return FAIL;
+    }
+    for (std::size_t i = 0; i < executorInfos.size(); i++) {
+        if (executorInfos[i] == nullptr || callbacks[i] == nullptr) {
+            COAUTH_HILOGE(MODULE_INNERKIT, "executorInfo or callback is nullptr");
+            return INVALID_PARAMETERS;
+        }
+        if (WriteAuthExecutor(*executorInfos[i], data) == FAIL) {
+            COAUTH_HILOGE(MODULE_INNERKIT, "write executorInfo failed");
+            return FAIL;
+        }
+        if (!data.WriteRemoteObject(callbacks[i]->AsObject())) {
+            COAUTH_HILOGE(MODULE_INNERKIT, "write callback failed");
+            return FAIL;
+        }
+    }
+    bool ret = SendRequest(static_cast<int32_t>(ICoAuth::COAUTH_EXECUTOR_REGIST_MANY), data, reply);
+    if (!ret) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "send request failed");
+        return FAIL;
+    }
+    int32_t result = FAIL;
+    if (!reply.ReadInt32(result) || !reply.ReadUInt64Vector(&executorIds)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "read reply failed");
+        return FAIL;
+    }
+    if (executorIds.size() != executorInfos.size()) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "reply size mismatch");
+        return FAIL;
+    }
+    return result;
+}
+
 void CoAuthProxy::QueryStatus(AuthResPool::AuthExecutor &executorInfo,
     const sptr<AuthResPool::IQueryCallback> &callback)
 {
@@ -271,6 +320,71 @@ void CoAuthProxy::SetExecutorProp(AuthResPool::AuthAttributes &conditions,
     }
 }
 
+int32_t CoAuthProxy::GetExecutorProps(std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &conditions,
+    std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &values, std::vector<int32_t> &results)
+{
+    COAUTH_HILOGD(MODULE_INNERKIT, "CoauthProxy: GetExecutorProps start");
+    MessageParcel data;
+    MessageParcel reply;
+
+    if (!data.WriteInterfaceToken(CoAuthProxy::GetDescriptor())) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write descriptor failed");
+        return FAIL;
+    }
+    if (!AuthResPool::AuthAttributes::WriteAttributesList(data, conditions)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write conditions failed");
+        return FAIL;
+    }
+    bool ret = SendRequest(static_cast<int32_t>(ICoAuth::COAUTH_GET_PROPERTIES), data, reply);
+    if (!ret) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "send request failed");
+        return FAIL;
+    }
+    int32_t result = FAIL;
+    if (!reply.ReadInt32(result) || !reply.ReadInt32Vector(&results) ||
+        !AuthResPool::AuthAttributes::ReadAttributesList(reply, values)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "read reply failed");
+        return FAIL;
+    }
+    if (results.size() != conditions.size() || values.size() != conditions.size()) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "reply size mismatch");
+        return FAIL;
+    }
+    return result;
+}
+
+int32_t CoAuthProxy::SetExecutorProps(std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &conditions,
+    std::vector<int32_t> &results)
+{
+    COAUTH_HILOGD(MODULE_INNERKIT, "CoauthProxy: SetExecutorProps start");
+    MessageParcel data;
+    MessageParcel reply;
+
+    if (!data.WriteInterfaceToken(CoAuthProxy::GetDescriptor())) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write descriptor failed");
+        return FAIL;
+    }
+    if (!AuthResPool::AuthAttributes::WriteAttributesList(data, conditions)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write conditions failed");
+        return FAIL;
+    }
+    bool ret = SendRequest(static_cast<int32_t>(ICoAuth::COAUTH_SET_PROPERTIES), data, reply);
+    if (!ret) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "send request failed");
+        return FAIL;
+    }
+    int32_t result = FAIL;
+    if (!reply.ReadInt32(result) || !reply.ReadInt32Vector(&results)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "read reply failed");
+        return FAIL;
+    }
+    if (results.size() != conditions.size()) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "reply size mismatch");
+        return FAIL;
+    }
+    return result;
+}
+
 bool CoAuthProxy::SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, bool isSync)
 {
     COAUTH_HILOGD(MODULE_INNERKIT, "CoauthProxy: SendRequest start");
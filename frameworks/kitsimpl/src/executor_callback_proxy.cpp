@@ -34,6 +34,7 @@ void ExecutorCallbackProxy::OnMessengerReady(const sptr<IExecutorMessenger> &mes
         COAUTH_HILOGE(MODULE_INNERKIT, "write RemoteObject failed");
         return;
     }
+    // Sync, so that the executor holds the messenger before the first OnBeginExecute can reach it.
     bool ret = SendRequest(static_cast<int32_t>(IExecutorCallback::ON_MESSENGER_READY), data, reply);
     COAUTH_HILOGD(MODULE_INNERKIT, "ret = %{public}d", ret);
 }
@@ -126,6 +127,39 @@ int32_t ExecutorCallbackProxy::OnEndExecute(uint64_t scheduleId, std::shared_ptr
     return result;
 }
 
+void ExecutorCallbackProxy::OnCancelExecute(uint64_t scheduleId, std::shared_ptr<AuthAttributes> consumerAttr)
+{
+    if (consumerAttr == nullptr) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "consumerAttr is null");
+        return;
+    }
+    MessageParcel data;
+    MessageParcel reply;
+    if (!data.WriteInterfaceToken(ExecutorCallbackProxy::GetDescriptor())) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write descriptor failed");
+        return;
+    }
+
+    if (!data.WriteUint64(scheduleId)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write scheduleId failed");
+        return;
+    }
+
+    std::vector<uint8_t> buffer;
+    if (consumerAttr->Pack(buffer) != SUCCESS) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "pack consumerAttr failed");
+        return;
+    }
+    if (!data.WriteUInt8Vector(buffer)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write buffer failed");
+        return;
+    }
+
+    // Same code as OnEndExecute, so executors need no new handler, the reply is simply dropped.
+    bool ret = SendRequest(static_cast<int32_t>(IExecutorCallback::ON_END_EXECUTE), data, reply, false);
+    COAUTH_HILOGD(MODULE_INNERKIT, "ret = %{public}d", ret);
+}
+
 int32_t ExecutorCallbackProxy::OnSetProperty(std::shared_ptr<AuthAttributes> properties)
 {
     if (properties == nullptr) {
@@ -211,15 +245,83 @@ int32_t ExecutorCallbackProxy::OnGetProperty(std::shared_ptr<AuthAttributes> con
     return result;
 }
 
+int32_t ExecutorCallbackProxy::OnGetProperties(std::vector<std::shared_ptr<AuthAttributes>> &conditions,
+    std::vector<std::shared_ptr<AuthAttributes>> &values, std::vector<int32_t> &results)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    if (!data.WriteInterfaceToken(ExecutorCallbackProxy::GetDescriptor())) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write descriptor failed");
+        return FAIL;
+    }
+    if (!AuthAttributes::WriteAttributesList(data, conditions)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write conditions failed");
+        return FAIL;
+    }
+    int32_t ret = SendSyncRequest(static_cast<int32_t>(IExecutorCallback::ON_GET_PROPERTIES), data, reply);
+    if (ret == OHOS::IPC_STUB_UNKNOW_TRANS_ERR) {
+        COAUTH_HILOGW(MODULE_INNERKIT, "executor does not support batched properties");
+        return BATCH_NOT_SUPPORT;
+    }
+    if (ret != OHOS::NO_ERROR) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "send request failed");
+        return FAIL;
+    }
+    int32_t result = FAIL;
+    if (!reply.ReadInt32(result) || !reply.ReadInt32Vector(&results) ||
+        !AuthAttributes::ReadAttributesList(reply, values)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "read reply failed");
+        return FAIL;
+    }
+    if (results.size() != conditions.size() || values.size() != conditions.size()) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "reply size mismatch");
+        return FAIL;
+    }
+    return result;
+}
+
+int32_t ExecutorCallbackProxy::OnSetProperties(std::vector<std::shared_ptr<AuthAttributes>> &properties,
+    std::vector<int32_t> &results)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    if (!data.WriteInterfaceToken(ExecutorCallbackProxy::GetDescriptor())) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write descriptor failed");
+        return FAIL;
+    }
+    if (!AuthAttributes::WriteAttributesList(data, properties)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write properties failed");
+        return FAIL;
+    }
+    int32_t ret = SendSyncRequest(static_cast<int32_t>(IExecutorCallback::ON_SET_PROPERTIES), data, reply);
+    if (ret == OHOS::IPC_STUB_UNKNOW_TRANS_ERR) {
+        COAUTH_HILOGW(MODULE_INNERKIT, "executor does not support batched properties");
+        return BATCH_NOT_SUPPORT;
+    }
+    if (ret != OHOS::NO_ERROR) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "send request failed");
+        return FAIL;
+    }
+    int32_t result = FAIL;
+    if (!reply.ReadInt32(result) || !reply.ReadInt32Vector(&results)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "read reply failed");
+        return FAIL;
+    }
+    if (results.size() != properties.size()) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "reply size mismatch");
+        return FAIL;
+    }
+    return result;
+}
 
-bool ExecutorCallbackProxy::SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply)
+bool ExecutorCallbackProxy::SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, bool isSync)
 {
     sptr<IRemoteObject> remote = Remote();
     if (remote == nullptr) {
         COAUTH_HILOGE(MODULE_INNERKIT, "get remote failed");
         return false;
     }
-    MessageOption option(MessageOption::TF_SYNC);
+    MessageOption option(isSync ? MessageOption::TF_SYNC : MessageOption::TF_ASYNC);
     int32_t result = remote->SendRequest(code, data, reply, option);
     if (result != OHOS::NO_ERROR) {
         COAUTH_HILOGE(MODULE_INNERKIT, "send request failed, result = %{public}d", result);
@@ -227,6 +329,22 @@ bool ExecutorCallbackProxy::SendRequest(uint32_t code, MessageParcel &data, Mess
     }
     return true;
 }
+
+/* Hands back the IPC result, so that a message code the executor does not know can be told apart */
+int32_t ExecutorCallbackProxy::SendSyncRequest(uint32_t code, MessageParcel &data, MessageParcel &reply)
+{
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "get remote failed");
+        return OHOS::IPC_PROXY_ERR;
+    }
+    MessageOption option(MessageOption::TF_SYNC);
+    int32_t result = remote->SendRequest(code, data, reply, option);
+    if (result != OHOS::NO_ERROR) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "send request failed, result = %{public}d", result);
+    }
+    return result;
+}
 }
 }
 }
\ No newline at end of file
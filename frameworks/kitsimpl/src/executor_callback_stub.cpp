@@ -49,6 +49,10 @@ int32_t ExecutorCallbackStub::OnRemoteRequest(uint32_t code, MessageParcel &data
             return OnSetPropertyStub(data, reply);
         case static_cast<int32_t>(IExecutorCallback::ON_GET_PROPERTY):
             return OnGetPropertyStub(data, reply);
+        case static_cast<int32_t>(IExecutorCallback::ON_GET_PROPERTIES):
+            return OnGetPropertiesStub(data, reply);
+        case static_cast<int32_t>(IExecutorCallback::ON_SET_PROPERTIES):
+            return OnSetPropertiesStub(data, reply);
         default:
             return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
     }
@@ -141,6 +145,40 @@ int32_t ExecutorCallbackStub::OnSetPropertyStub(MessageParcel &data, MessageParc
     return SUCCESS;
 }
 
+int32_t ExecutorCallbackStub::OnGetPropertiesStub(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<std::shared_ptr<AuthAttributes>> conditions;
+    if (!AuthAttributes::ReadAttributesList(data, conditions)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "read conditions failed");
+        return FAIL;
+    }
+    std::vector<std::shared_ptr<AuthAttributes>> values;
+    std::vector<int32_t> results;
+    int32_t ret = OnGetProperties(conditions, values, results);
+    if (!reply.WriteInt32(ret) || !reply.WriteInt32Vector(results) ||
+        !AuthAttributes::WriteAttributesList(reply, values)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write reply failed");
+        return FAIL;
+    }
+    return SUCCESS;
+}
+
+int32_t ExecutorCallbackStub::OnSetPropertiesStub(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<std::shared_ptr<AuthAttributes>> properties;
+    if (!AuthAttributes::ReadAttributesList(data, properties)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "read properties failed");
+        return FAIL;
+    }
+    std::vector<int32_t> results;
+    int32_t ret = OnSetProperties(properties, results);
+    if (!reply.WriteInt32(ret) || !reply.WriteInt32Vector(results)) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write reply failed");
+        return FAIL;
+    }
+    return SUCCESS;
+}
+
 void ExecutorCallbackStub::OnMessengerReady(const sptr<IExecutorMessenger> &messenger)
 {
     if (callback_ == nullptr) {
@@ -173,6 +211,11 @@ int32_t ExecutorCallbackStub::OnEndExecute(uint64_t scheduleId, std::shared_ptr<
     return ret;
 }
 
+void ExecutorCallbackStub::OnCancelExecute(uint64_t scheduleId, std::shared_ptr<AuthAttributes> consumerAttr)
+{
+    OnEndExecute(scheduleId, consumerAttr);
+}
+
 int32_t ExecutorCallbackStub::OnSetProperty(std::shared_ptr<AuthAttributes> properties)
 {
     int32_t ret = FAIL;
@@ -195,6 +238,30 @@ int32_t ExecutorCallbackStub::OnGetProperty(std::shared_ptr<AuthAttributes> cond
     }
     return ret;
 }
+
+int32_t ExecutorCallbackStub::OnGetProperties(std::vector<std::shared_ptr<AuthAttributes>> &conditions,
+    std::vector<std::shared_ptr<AuthAttributes>> &values, std::vector<int32_t> &results)
+{
+    // The executor implements single queries, the batch only saves the binder round trips.
+    values.clear();
+    results.clear();
+    for (auto &condition : conditions) {
+        std::shared_ptr<AuthAttributes> value = std::make_shared<AuthAttributes>();
+        results.push_back(OnGetProperty(condition, value));
+        values.push_back(value);
+    }
+    return SUCCESS;
+}
+
+int32_t ExecutorCallbackStub::OnSetProperties(std::vector<std::shared_ptr<AuthAttributes>> &properties,
+    std::vector<int32_t> &results)
+{
+    results.clear();
+    for (auto &property : properties) {
+        results.push_back(OnSetProperty(property));
+    }
+    return SUCCESS;
+}
 } // namespace AuthResPool
 } // namespace UserIAM
 } // namespace OHOS
\ No newline at end of file
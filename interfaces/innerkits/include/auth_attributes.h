@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <algorithm>
 #include "coauth_info_define.h"
 #include "iremote_object.h"
@@ -33,6 +34,8 @@ namespace AuthResPool {
 class AuthAttributes {
 public:
     AuthAttributes();
+    AuthAttributes(const AuthAttributes &other) = default;
+    AuthAttributes &operator=(const AuthAttributes &other) = default;
     ~AuthAttributes() {};
     void clear();
     int32_t GetBoolValue(AuthAttributeType attrType, bool &value);
@@ -50,6 +53,9 @@ public:
     int32_t SetUint64ArrayValue(AuthAttributeType attrType, std::vector<uint64_t> &value);
     int32_t SetUint8ArrayValue(AuthAttributeType attrType, std::vector<uint8_t> &value);
     AuthAttributes* Unpack(std::vector<uint8_t> &buffer);
+    // A count followed by the encoded attributes, at most MAX_PROPERTY_BATCH_NUM of them.
+    static bool WriteAttributesList(Parcel &parcel, const std::vector<std::shared_ptr<AuthAttributes>> &list);
+    static bool ReadAttributesList(Parcel &parcel, std::vector<std::shared_ptr<AuthAttributes>> &list);
     enum ValueType {
         BOOLTYPE = 1,
         UINT32TYPE = 2,
@@ -69,6 +75,9 @@ private:
     std::map<AuthAttributeType, std::vector<uint8_t>> uint8ArrayValueMap_;
     std::map<AuthAttributeType, ValueType> authAttributesPosition_;
     std::vector<AuthAttributeType> existAttributes_;
+    // Encoded form from the last Pack, returned by Pack until a value changes. Received bytes are never kept, so
+    // Pack always sends a normalized encoding.
+    std::vector<uint8_t> encoded_;
     AuthAttributeType GetUint32FromUint8(std::vector<uint8_t> &data, uint32_t begin);
     bool GetBoolFromUint8(std::vector<uint8_t> &data, uint32_t begin);
     uint64_t  GetUint64FromUint8(std::vector<uint8_t> &data, uint32_t begin);
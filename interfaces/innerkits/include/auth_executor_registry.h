@@ -16,6 +16,9 @@
 #ifndef AUTH_EXECUTOR_REGISTRY_H
 #define AUTH_EXECUTOR_REGISTRY_H
 
+#include <memory>
+#include <vector>
+#include <isystem_ability_status_change.h>
 #include "i_coauth.h"
 #include "query_callback.h"
 #include "executor_callback.h"
@@ -29,8 +32,15 @@ class AuthExecutorRegistry : public DelayedRefSingleton<AuthExecutorRegistry> {
 public:
 DISALLOW_COPY_AND_MOVE(AuthExecutorRegistry);
 /* InnerKit */
+// A callback that is registered already keeps its executor ID, unregister it first to change the executor info.
+// It may be called from the callbacks of an executor, a callback whose registration is still being sent fails.
 uint64_t Register(std::shared_ptr<AuthExecutor> executorInfo, std::shared_ptr<ExecutorCallback> callback);
+// Forgets the registration, so the executor is not registered again after a service restart. The service keeps
+// the executor until the executor process exits, as it did before.
+int32_t Unregister(std::shared_ptr<ExecutorCallback> callback);
 void QueryStatus(AuthExecutor &executorInfo, std::shared_ptr<QueryCallback> callback);
+// Called when the service comes up, connects so that later calls find the proxy ready.
+void PreConnect();
 
 private:
     class AuthExecutorRegistryDeathRecipient : public IRemoteObject::DeathRecipient {
@@ -42,11 +52,36 @@ private:
     private:
         DISALLOW_COPY_AND_MOVE(AuthExecutorRegistryDeathRecipient);
     };
+    // An executor registered by this process, registered again when the service comes back.
+    struct RegisteredExecutor {
+        std::shared_ptr<AuthExecutor> executorInfo;
+        std::shared_ptr<ExecutorCallback> callback;
+        sptr<IExecutorCallback> stub;
+        uint64_t executorId;
+        bool registered;
+        // Set while a registration is sent, only the result of the latest attempt is taken.
+        bool registering;
+        uint32_t attempt;
+    };
+    void ReRegister();
+    void SendReRegister(std::vector<RegisteredExecutor> &executors, std::vector<RegisteredExecutor> &changed);
+    bool FinishRegister(const std::shared_ptr<ExecutorCallback> &callback, uint32_t attempt, uint64_t executorId,
+        bool forgetOnFailure);
     void ResetProxy(const wptr<IRemoteObject>& remote);
     sptr<CoAuth::ICoAuth> GetProxy();
+    sptr<CoAuth::ICoAuth> Connect();
+    void SubscribeServiceStatus();
     std::mutex mutex_;
     sptr<CoAuth::ICoAuth> proxy_ {nullptr};
+    // proxy_ published for the lock free path through std::atomic_load and std::atomic_store, a reader keeps a
+    // reset proxy alive until it drops its copy.
+    std::shared_ptr<const sptr<CoAuth::ICoAuth>> publishedProxy_ {nullptr};
+    sptr<ISystemAbilityStatusChange> statusListener_ {nullptr};
     sptr<IRemoteObject::DeathRecipient> deathRecipient_ {nullptr};
+    // Lock order is mutex_ before executorsMutex_. Neither is held across a call to the service, which calls the
+    // executor back before it replies.
+    std::mutex executorsMutex_;
+    std::vector<RegisteredExecutor> executors_;
 };
 } // namespace AuthResPool
 } // namespace UserIAM
@@ -16,7 +16,10 @@
 #ifndef CO_AUTH_H
 #define CO_AUTH_H
 
+#include <memory>
+#include <vector>
 #include <iremote_object.h>
+#include <isystem_ability_status_change.h>
 #include <singleton.h>
 #include "coauth_callback.h"
 #include "set_prop_callback.h"
@@ -37,6 +40,14 @@ public:
     int32_t GetExecutorProp(AuthResPool::AuthAttributes &conditions,
                             std::shared_ptr<AuthResPool::AuthAttributes> values);
     void SetExecutorProp(AuthResPool::AuthAttributes &conditions, std::shared_ptr<SetPropCallback> callback);
+    // One round trip for several condition sets, results and values follow the order of conditions.
+    int32_t GetExecutorProps(std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &conditions,
+                             std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &values,
+                             std::vector<int32_t> &results);
+    int32_t SetExecutorProps(std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> &conditions,
+                             std::vector<int32_t> &results);
+    // Called when the service comes up, connects so that later calls find the proxy ready.
+    void PreConnect();
 
 private:
     class CoAuthDeathRecipient : public IRemoteObject::DeathRecipient {
@@ -50,8 +61,14 @@ private:
     };
     void ResetProxy(const wptr<IRemoteObject>& remote);
     sptr<ICoAuth> GetProxy();
+    sptr<ICoAuth> Connect();
+    void SubscribeServiceStatus();
     std::mutex mutex_;
     sptr<ICoAuth> proxy_ {nullptr};
+    // proxy_ published for the lock free path through std::atomic_load and std::atomic_store, a reader keeps a
+    // reset proxy alive until it drops its copy.
+    std::shared_ptr<const sptr<ICoAuth>> publishedProxy_ {nullptr};
+    sptr<ISystemAbilityStatusChange> statusListener_ {nullptr};
     sptr<IRemoteObject::DeathRecipient> deathRecipient_ {nullptr};
 };
 } // namespace CoAuth
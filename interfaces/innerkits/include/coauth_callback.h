@@ -28,6 +28,12 @@ class CoAuthCallback {
 public:
     virtual void OnFinish(uint32_t resultCode, std::vector<uint8_t> &scheduleToken) = 0;
     virtual void OnAcquireInfo(uint32_t acquire) = 0;
+    // Acquire info sent with an executor defined payload, callers that do not use it get the code only.
+    virtual void OnAcquireExtraInfo(uint32_t acquire, std::vector<uint8_t> &extraInfo)
+    {
+        (void)extraInfo;
+        OnAcquireInfo(acquire);
+    }
 };
 } // namespace CoAuth
 } // namespace UserIAM
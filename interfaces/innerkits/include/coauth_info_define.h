@@ -163,6 +163,12 @@ enum ResultCode {
 };
 
 const uint64_t INVALID_EXECUTOR_ID = 0;
+/* Max condition sets carried by one batched property request */
+const uint32_t MAX_PROPERTY_BATCH_NUM = 32;
+/* Max executors carried by one RegisterMany request */
+const uint32_t MAX_REGISTER_BATCH_NUM = 16;
+/* Max bytes following the acquire code in an acquire info message */
+const uint32_t MAX_ACQUIRE_EXTRA_INFO_LEN = 1024;
 } // namespace UserIAM
 } // namespace OHOS
 #endif // COAUTH_INFO_DEFINE_H
@@ -30,6 +30,11 @@ public:
     virtual int32_t OnSetProperty(std::shared_ptr<AuthAttributes> properties)  = 0;
     virtual int32_t OnGetProperty(std::shared_ptr<AuthAttributes> conditions,
                                   std::shared_ptr<AuthAttributes> values) = 0;
+    // The registry registered the executor again after the service restarted, executorId replaces the old one.
+    virtual void OnExecutorIdChanged(uint64_t executorId)
+    {
+        (void)executorId;
+    }
 };
 } // namespace AuthResPool
 } // namespace UserIAM
@@ -53,6 +53,7 @@ void AuthAttributes::clear()
     uint32ArraylValueMap_.clear();
     uint64ArraylValueMap_.clear();
     uint8ArrayValueMap_.clear();
+    encoded_.clear();
 }
 
 int32_t AuthAttributes::GetBoolValue(AuthAttributeType attrType, bool &value)
@@ -122,6 +123,7 @@ int32_t AuthAttributes::SetBoolValue(AuthAttributeType attrType, bool value)
     }
     boolValueMap_[attrType] = value;
     existAttributes_.push_back(attrType);
+    encoded_.clear();
     return SUCCESS;
 }
 
@@ -132,6 +134,7 @@ int32_t AuthAttributes::SetUint32Value(AuthAttributeType attrType, uint32_t valu
     }
     uint32ValueMap_[attrType] = value;
     existAttributes_.push_back(attrType);
+    encoded_.clear();
     COAUTH_HILOGD(MODULE_INNERKIT, "SetUint32Value : %{public}u.", value);
     return SUCCESS;
 }
@@ -143,6 +146,7 @@ int32_t AuthAttributes::SetUint64Value(AuthAttributeType attrType, uint64_t valu
     }
     uint64ValueMap_[attrType] = value;
     existAttributes_.push_back(attrType);
+    encoded_.clear();
     return SUCCESS;
 }
 
@@ -153,6 +157,7 @@ int32_t AuthAttributes::SetUint32ArrayValue(AuthAttributeType attrType, std::vec
     }
     uint32ArraylValueMap_[attrType] = value;
     existAttributes_.push_back(attrType);
+    encoded_.clear();
     return SUCCESS;
 }
 
@@ -163,6 +168,7 @@ int32_t AuthAttributes::SetUint64ArrayValue(AuthAttributeType attrType, std::vec
     }
     uint64ArraylValueMap_[attrType] = value;
     existAttributes_.push_back(attrType);
+    encoded_.clear();
     return SUCCESS;
 }
 
@@ -173,6 +179,7 @@ int32_t AuthAttributes::SetUint8ArrayValue(AuthAttributeType attrType, std::vect
     }
     uint8ArrayValueMap_[attrType] = value;
     existAttributes_.push_back(attrType);
+    encoded_.clear();
     return SUCCESS;
 }
 
@@ -292,6 +299,43 @@ AuthAttributes* AuthAttributes::Unpack(std::vector<uint8_t> &buffer)
     return this;
 }
 
+bool AuthAttributes::WriteAttributesList(Parcel &parcel, const std::vector<std::shared_ptr<AuthAttributes>> &list)
+{
+    if (list.size() > MAX_PROPERTY_BATCH_NUM || !parcel.WriteUint32(static_cast<uint32_t>(list.size()))) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "write attributes num failed");
+        return false;
+    }
+    std::vector<uint8_t> buffer;
+    for (const auto &attributes : list) {
+        if (attributes == nullptr || attributes->Pack(buffer) != SUCCESS || !parcel.WriteUInt8Vector(buffer)) {
+            COAUTH_HILOGE(MODULE_INNERKIT, "write attributes failed");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AuthAttributes::ReadAttributesList(Parcel &parcel, std::vector<std::shared_ptr<AuthAttributes>> &list)
+{
+    uint32_t num = 0;
+    if (!parcel.ReadUint32(num) || num > MAX_PROPERTY_BATCH_NUM) {
+        COAUTH_HILOGE(MODULE_INNERKIT, "read attributes num failed");
+        return false;
+    }
+    list.clear();
+    std::vector<uint8_t> buffer;
+    for (uint32_t i = 0; i < num; i++) {
+        if (!parcel.ReadUInt8Vector(&buffer)) {
+            COAUTH_HILOGE(MODULE_INNERKIT, "read attributes failed");
+            return false;
+        }
+        auto attributes = std::make_shared<AuthAttributes>();
+        attributes->Unpack(buffer);
+        list.push_back(attributes);
+    }
+    return true;
+}
+
 AuthAttributeType AuthAttributes::GetUint32FromUint8(std::vector<uint8_t> &data, uint32_t begin)
 {
     if (begin >= data.size() || data.size() - begin < sizeof(uint32_t)) {
@@ -356,6 +400,10 @@ int32_t AuthAttributes::Pack(std::vector<uint8_t> &buffer)
     uint32_t dataLength = 0;
     uint32_t tag;
     uint32_t authDataLength = 0;
+    if (!encoded_.empty()) {
+        buffer = encoded_;
+        return SUCCESS;
+    }
     buffer.clear();
     sort(existAttributes_.begin(), existAttributes_.end());
     for (uint32_t i = 0; i != existAttributes_.size(); i++) {
@@ -390,6 +438,7 @@ int32_t AuthAttributes::Pack(std::vector<uint8_t> &buffer)
     tag = AUTH_ROOT;
     writePointer = static_cast<uint8_t*>(static_cast<void *>(&tag));
     buffer.insert(buffer.begin(), writePointer, writePointer + sizeof(AuthAttributeType));
+    encoded_ = buffer;
     return SUCCESS;
 }
 
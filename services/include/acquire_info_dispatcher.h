@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ACQUIRE_INFO_DISPATCHER_H
+#define ACQUIRE_INFO_DISPATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <singleton.h>
+#include "icoauth_callback.h"
+
+namespace OHOS {
+namespace UserIAM {
+namespace CoAuth {
+#ifndef ACQUIRE_INFO_MIN_INTERVAL_MS
+#define ACQUIRE_INFO_MIN_INTERVAL_MS 100
+#endif
+
+// Forwards executor acquire info to the schedule callback. A tip equal to the last one of its schedule is dropped,
+// and a schedule gets at most one tip per ACQUIRE_INFO_MIN_INTERVAL_MS, the latest tip held back in that interval
+// is sent by the dispatcher thread when the interval ends.
+class AcquireInfoDispatcher : public DelayedRefSingleton<AcquireInfoDispatcher> {
+    DECLARE_DELAYED_REF_SINGLETON(AcquireInfoDispatcher);
+public:
+    DISALLOW_COPY_AND_MOVE(AcquireInfoDispatcher);
+
+    void Begin(uint64_t scheduleId, const sptr<ICoAuthCallback> &callback);
+    // Returns false when the schedule has not begun or has ended, its tip is dropped.
+    bool Dispatch(uint64_t scheduleId, uint32_t acquire, const std::vector<uint8_t> &extraInfo);
+    // Drops the state and any held back tip, and waits for a tip being sent. Call it before the schedule reports
+    // its result, so that no tip can reach the callback after the result. The callback must not wait on a call
+    // that ends the same schedule.
+    void EndSchedule(uint64_t scheduleId);
+
+private:
+    struct AcquireInfo {
+        uint32_t acquire;
+        std::vector<uint8_t> extraInfo;
+        bool operator==(const AcquireInfo &other) const
+        {
+            return acquire == other.acquire && extraInfo == other.extraInfo;
+        }
+    };
+    struct ScheduleState {
+        sptr<ICoAuthCallback> callback;
+        // Set by EndSchedule, a tip is only sent while it is false.
+        bool ended = false;
+        uint32_t sendingNum = 0;
+        bool hasLast = false;
+        AcquireInfo last;
+        std::chrono::steady_clock::time_point lastSendTime;
+        bool hasPending = false;
+        AcquireInfo pending;
+    };
+    struct Delivery {
+        uint64_t scheduleId;
+        sptr<ICoAuthCallback> callback;
+        AcquireInfo info;
+    };
+
+    void Deliver(Delivery &delivery);
+    void CollectDueLocked(std::chrono::steady_clock::time_point now, std::vector<Delivery> &deliveries);
+    void Run();
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::condition_variable sentCondition_;
+    std::unordered_map<uint64_t, ScheduleState> states_;
+    uint32_t pendingNum_ = 0;
+    bool running_ = true;
+    std::thread thread_;
+};
+} // namespace CoAuth
+} // namespace UserIAM
+} // namespace OHOS
+#endif // ACQUIRE_INFO_DISPATCHER_H
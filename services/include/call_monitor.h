@@ -16,29 +16,57 @@
 #ifndef CALL_MONITOR_H
 #define CALL_MONITOR_H
 
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
 #include <stdint.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include <singleton.h>
 #include "coauth_hilog_wrapper.h"
-#include "event_handler.h"
 
 namespace OHOS {
 namespace UserIAM {
 namespace CoAuth {
-using Callback = OHOS::AppExecFwk::EventHandler::Callback;
+using Callback = std::function<void()>;
 
+// Schedule timeouts on a hashed timing wheel keyed by scheduleId, arm and remove are O(1) and the timeouts
+// due in one tick run together on the wheel thread.
 class CallMonitor : public DelayedRefSingleton<CallMonitor> {
     DECLARE_DELAYED_REF_SINGLETON(CallMonitor);
 public:
     DISALLOW_COPY_AND_MOVE(CallMonitor);
 
+    // waitTime is in milliseconds, monitoring a scheduleId again replaces its previous timeout.
     void MonitorCall(int64_t waitTime, uint64_t scheduleId, Callback &timeoutFun);
 
     void MonitorRemoveCall(uint64_t scheduleId);
 private:
-    std::shared_ptr<AppExecFwk::EventHandler> eventHandler_;
+    struct TimerNode {
+        uint64_t rounds;
+        uint32_t slot;
+        std::list<uint64_t>::iterator position;
+        Callback timeoutFun;
+    };
+
+    void RemoveTimerLocked(uint64_t scheduleId);
+    void CollectExpiredLocked(std::vector<Callback> &expired);
+    void Run();
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::vector<std::list<uint64_t>> slots_;
+    std::unordered_map<uint64_t, TimerNode> timers_;
+    uint32_t currentSlot_ = 0;
+    std::chrono::steady_clock::time_point nextTick_;
+    bool running_ = true;
+    std::thread thread_;
 };
 } // namespace CoAuth
 } // namespace UserIAM
 } // namespace OHOS
 
-#endif // CALL_MONITOR_H
\ No newline at end of file
+#endif // CALL_MONITOR_H
@@ -22,17 +22,21 @@
 #include "call_monitor.h"
 #include "iquery_callback.h"
 #include "auth_res_manager.h"
+#include "schedule_timeout_policy.h"
 
 namespace OHOS {
 namespace UserIAM {
 namespace CoAuth {
-const int64_t delay_time = 300 * 1000;
 class CoAuthManager {
 public:
     void BeginSchedule(uint64_t scheduleId, AuthInfo &authInfo, sptr<ICoAuthCallback> callback);
     int32_t Cancel(uint64_t scheduleId);
     int32_t GetExecutorProp(ResAuthAttributes &conditions, std::shared_ptr<ResAuthAttributes> values);
     void SetExecutorProp(ResAuthAttributes &conditions, sptr<ISetPropCallback> callback);
+    int32_t GetExecutorProps(std::vector<std::shared_ptr<ResAuthAttributes>> &conditions,
+                             std::vector<std::shared_ptr<ResAuthAttributes>> &values, std::vector<int32_t> &results);
+    int32_t SetExecutorProps(std::vector<std::shared_ptr<ResAuthAttributes>> &conditions,
+                             std::vector<int32_t> &results);
     void RegistResourceManager(AuthResManager* resMgr);
 
     void CoAuthHandle(uint64_t scheduleId, AuthInfo &authInfo, sptr<ICoAuthCallback> callback);
@@ -40,6 +44,13 @@ public:
 private:
     void SetAuthAttributes(std::shared_ptr<ResAuthAttributes> commandAttrs,
                            ScheduleInfo &scheduleInfo, AuthInfo &authInfo);
+    void GetExecutorPropsByType(uint32_t authType, const std::vector<std::size_t> &indexes,
+                                std::vector<std::shared_ptr<ResAuthAttributes>> &conditions,
+                                std::vector<std::shared_ptr<ResAuthAttributes>> &values,
+                                std::vector<int32_t> &results);
+    void SetExecutorPropsByType(uint32_t authType, const std::vector<std::size_t> &indexes,
+                                std::vector<std::shared_ptr<ResAuthAttributes>> &conditions,
+                                std::vector<int32_t> &results);
     void BeginExecute(ScheduleInfo &scheduleInfo, std::size_t executorNum, uint64_t scheduleId,
                       AuthInfo &authInfo, int32_t &executeRet);
     class ResICoAuthCallbackDeathRecipient : public IRemoteObject::DeathRecipient {
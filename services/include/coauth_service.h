@@ -42,13 +42,22 @@ public:
     virtual ~CoAuthService() override;
     void OnStart() override;
     void OnStop() override;
+    int Dump(int fd, const std::vector<std::u16string> &args) override;
     virtual uint64_t Register(std::shared_ptr<ResAuthExecutor> executorInfo,
                               const sptr<ResIExecutorCallback> &callback) override;
     virtual void QueryStatus(ResAuthExecutor &executorInfo, const sptr<ResIQueryCallback> &callback) override;
+    virtual int32_t RegisterMany(std::vector<std::shared_ptr<ResAuthExecutor>> &executorInfos,
+                                 std::vector<sptr<ResIExecutorCallback>> &callbacks,
+                                 std::vector<uint64_t> &executorIds) override;
     virtual void BeginSchedule(uint64_t scheduleId, AuthInfo &authInfo, const sptr<ICoAuthCallback> &callback) override;
     virtual int32_t Cancel(uint64_t scheduleId) override;
     virtual int32_t GetExecutorProp(ResAuthAttributes &conditions, std::shared_ptr<ResAuthAttributes> values) override;
     virtual void SetExecutorProp(ResAuthAttributes &conditions, const sptr<ISetPropCallback> &callback) override;
+    virtual int32_t GetExecutorProps(std::vector<std::shared_ptr<ResAuthAttributes>> &conditions,
+                                     std::vector<std::shared_ptr<ResAuthAttributes>> &values,
+                                     std::vector<int32_t> &results) override;
+    virtual int32_t SetExecutorProps(std::vector<std::shared_ptr<ResAuthAttributes>> &conditions,
+                                     std::vector<int32_t> &results) override;
 
 private:
     CoAuthRunningState state_ = CoAuthRunningState::STATE_STOPPED;
@@ -34,10 +34,13 @@ public:
 private:
     int32_t RegisterStub(MessageParcel& data, MessageParcel& reply);
     int32_t QueryStatusStub(MessageParcel& data, MessageParcel& reply);
+    int32_t RegisterManyStub(MessageParcel& data, MessageParcel& reply);
     int32_t BeginScheduleStub(MessageParcel &data, MessageParcel &reply);
     int32_t CancelStub(MessageParcel &data, MessageParcel &reply);
     int32_t GetExecutorPropStub(MessageParcel &data, MessageParcel &reply);
     int32_t SetExecutorPropStub(MessageParcel &data, MessageParcel &reply);
+    int32_t GetExecutorPropsStub(MessageParcel &data, MessageParcel &reply);
+    int32_t SetExecutorPropsStub(MessageParcel &data, MessageParcel &reply);
     void ReadAuthExecutor(AuthResPool::AuthExecutor &executorInfo, MessageParcel& data);
 };
 } // namespace CoAuth
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXECUTOR_PROP_CACHE_H
+#define EXECUTOR_PROP_CACHE_H
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <tuple>
+#include <vector>
+#include <singleton.h>
+#include "auth_attributes.h"
+
+namespace OHOS {
+namespace UserIAM {
+namespace CoAuth {
+// Caches GetExecutorProp results by (authType, templateId, propertyMode) for a short TTL, only built with
+// useriam_executor_prop_cache. An entry is used only for byte identical conditions. Entries of an authType are
+// dropped by SetExecutorProp, and all entries when a schedule finishes or an executor goes away, since those
+// change remaining attempts, lockout state and templates.
+class ExecutorPropCache : public DelayedRefSingleton<ExecutorPropCache> {
+    DECLARE_DELAYED_REF_SINGLETON(ExecutorPropCache);
+public:
+    DISALLOW_COPY_AND_MOVE(ExecutorPropCache);
+
+    bool Find(UserIAM::AuthResPool::AuthAttributes &conditions, const std::vector<uint8_t> &packedConditions,
+        std::shared_ptr<UserIAM::AuthResPool::AuthAttributes> values);
+    void Save(UserIAM::AuthResPool::AuthAttributes &conditions, const std::vector<uint8_t> &packedConditions,
+        std::shared_ptr<UserIAM::AuthResPool::AuthAttributes> values);
+    void Invalidate(uint32_t authType);
+    void InvalidateAll();
+
+private:
+    using CacheKey = std::tuple<uint32_t, uint64_t, uint32_t>;
+    struct CacheEntry {
+        std::vector<uint8_t> conditions;
+        std::vector<uint8_t> values;
+        std::chrono::steady_clock::time_point expireTime;
+    };
+
+    static CacheKey GetKey(UserIAM::AuthResPool::AuthAttributes &conditions);
+    void RemoveExpiredLocked(std::chrono::steady_clock::time_point now);
+
+    std::mutex mutex_;
+    std::map<CacheKey, CacheEntry> entries_;
+};
+} // namespace CoAuth
+} // namespace UserIAM
+} // namespace OHOS
+#endif // EXECUTOR_PROP_CACHE_H
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SCHEDULE_TIMEOUT_POLICY_H
+#define SCHEDULE_TIMEOUT_POLICY_H
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <singleton.h>
+#include "coauth_interface.h"
+
+namespace OHOS {
+namespace UserIAM {
+namespace CoAuth {
+const int64_t delay_time = 300 * 1000;
+const std::string SCHEDULE_TIMEOUT_CONFIG_PATH = "/system/etc/useriam/schedule_timeout.conf";
+
+// Chooses the timeout of a schedule. Configured rules win, the most specific one first:
+// (authType, scheduleMode, executorId), (authType, scheduleMode, *), (authType, *, executorId), (authType, *, *)
+// and (*, *, *). Without a rule, the timeout adapts to the completion latencies observed for the authType and
+// scheduleMode once enough schedules finished, and is delay_time before that.
+class ScheduleTimeoutPolicy : public DelayedRefSingleton<ScheduleTimeoutPolicy> {
+    DECLARE_DELAYED_REF_SINGLETON(ScheduleTimeoutPolicy);
+public:
+    DISALLOW_COPY_AND_MOVE(ScheduleTimeoutPolicy);
+
+    // One rule per line: "authType scheduleMode executorId timeoutMs", "*" matches any value, "#" starts a comment.
+    bool LoadConfig(const std::string &path);
+    // Returns the timeout in milliseconds and starts measuring the schedule.
+    int64_t BeginSchedule(uint64_t scheduleId, const ScheduleInfo &scheduleInfo);
+    // The executor finished the schedule, its latency becomes a sample.
+    void FinishSchedule(uint64_t scheduleId);
+    // The schedule timed out, counted as a sample of the timeout it had.
+    void TimeoutSchedule(uint64_t scheduleId);
+    // The schedule ended without a result, no sample is taken.
+    void EndSchedule(uint64_t scheduleId);
+
+private:
+    using RuleKey = std::tuple<uint32_t, uint32_t, uint64_t>;
+    using LatencyKey = std::pair<uint32_t, uint32_t>;
+    struct RunningSchedule {
+        LatencyKey key;
+        int64_t timeout;
+        std::chrono::steady_clock::time_point begin;
+    };
+    struct LatencyStats {
+        uint32_t sampleNum;
+        int64_t average;
+        int64_t deviation;
+    };
+
+    bool ParseRule(const std::string &line, RuleKey &key, int64_t &timeout);
+    bool FindRuleLocked(const ScheduleInfo &scheduleInfo, int64_t &timeout);
+    int64_t GetAdaptiveTimeoutLocked(const LatencyKey &key);
+    void AddSampleLocked(const LatencyKey &key, int64_t latency);
+
+    std::mutex mutex_;
+    std::map<RuleKey, int64_t> rules_;
+    std::map<LatencyKey, LatencyStats> latencies_;
+    std::unordered_map<uint64_t, RunningSchedule> running_;
+};
+} // namespace CoAuth
+} // namespace UserIAM
+} // namespace OHOS
+#endif // SCHEDULE_TIMEOUT_POLICY_H
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "acquire_info_dispatcher.h"
+#include "coauth_hilog_wrapper.h"
+
+namespace OHOS {
+namespace UserIAM {
+namespace CoAuth {
+namespace {
+constexpr std::chrono::milliseconds MIN_INTERVAL(ACQUIRE_INFO_MIN_INTERVAL_MS);
+}
+
+AcquireInfoDispatcher::AcquireInfoDispatcher()
+{
+    thread_ = std::thread(&AcquireInfoDispatcher::Run, this);
+}
+
+AcquireInfoDispatcher::~AcquireInfoDispatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    condition_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void AcquireInfoDispatcher::Begin(uint64_t scheduleId, const sptr<ICoAuthCallback> &callback)
+{
+    if (callback == nullptr) {
+        COAUTH_HILOGE(MODULE_SERVICE, "callback is nullptr");
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    ScheduleState &state = states_[scheduleId];
+    if (state.callback != nullptr) {
+        COAUTH_HILOGW(MODULE_SERVICE, "schedule has begun");
+        return;
+    }
+    state.callback = callback;
+}
+
+bool AcquireInfoDispatcher::Dispatch(uint64_t scheduleId, uint32_t acquire, const std::vector<uint8_t> &extraInfo)
+{
+    AcquireInfo info = { acquire, extraInfo };
+    Delivery delivery;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = states_.find(scheduleId);
+        if (iter == states_.end() || iter->second.ended) {
+            COAUTH_HILOGW(MODULE_SERVICE, "schedule is not running, drop the tip");
+            return false;
+        }
+        ScheduleState &state = iter->second;
+        if (state.hasPending && state.pending == info) {
+            return true;
+        }
+        if (state.hasLast && state.last == info) {
+            // The held back tip was taken back before it was sent.
+            if (state.hasPending) {
+                state.hasPending = false;
+                pendingNum_--;
+            }
+            return true;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (state.hasLast && now - state.lastSendTime < MIN_INTERVAL) {
+            if (!state.hasPending) {
+                state.hasPending = true;
+                pendingNum_++;
+                condition_.notify_one();
+            }
+            state.pending = std::move(info);
+            return true;
+        }
+        if (state.hasPending) {
+            state.hasPending = false;
+            pendingNum_--;
+        }
+        state.hasLast = true;
+        state.last = info;
+        state.lastSendTime = now;
+        state.sendingNum++;
+        delivery = { scheduleId, state.callback, std::move(info) };
+    }
+    Deliver(delivery);
+    return true;
+}
+
+void AcquireInfoDispatcher::EndSchedule(uint64_t scheduleId)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto iter = states_.find(scheduleId);
+    if (iter == states_.end()) {
+        return;
+    }
+    if (iter->second.hasPending) {
+        iter->second.hasPending = false;
+        pendingNum_--;
+    }
+    iter->second.ended = true;
+    // The iterator may be invalidated by a schedule beginning meanwhile, so look the state up again.
+    sentCondition_.wait(lock, [this, scheduleId] {
+        auto iter = states_.find(scheduleId);
+        return iter == states_.end() || iter->second.sendingNum == 0;
+    });
+    states_.erase(scheduleId);
+}
+
+// The caller has counted the delivery in sendingNum, it is only sent if the schedule has not ended meanwhile.
+void AcquireInfoDispatcher::Deliver(Delivery &delivery)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = states_.find(delivery.scheduleId);
+        if (iter == states_.end()) {
+            return;
+        }
+        if (iter->second.ended) {
+            iter->second.sendingNum--;
+            sentCondition_.notify_all();
+            return;
+        }
+    }
+    if (delivery.info.extraInfo.empty()) {
+        delivery.callback->OnAcquireInfo(delivery.info.acquire);
+    } else {
+        delivery.callback->OnAcquireExtraInfo(delivery.info.acquire, delivery.info.extraInfo);
+    }
+    COAUTH_HILOGD(MODULE_SERVICE, "feedback acquire info");
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = states_.find(delivery.scheduleId);
+    if (iter != states_.end()) {
+        iter->second.sendingNum--;
+        sentCondition_.notify_all();
+    }
+}
+
+void AcquireInfoDispatcher::CollectDueLocked(std::chrono::steady_clock::time_point now,
+    std::vector<Delivery> &deliveries)
+{
+    for (auto &iter : states_) {
+        ScheduleState &state = iter.second;
+        if (!state.hasPending || now - state.lastSendTime < MIN_INTERVAL) {
+            continue;
+        }
+        state.hasPending = false;
+        pendingNum_--;
+        state.last = state.pending;
+        state.lastSendTime = now;
+        state.sendingNum++;
+        deliveries.push_back({ iter.first, state.callback, std::move(state.pending) });
+    }
+}
+
+void AcquireInfoDispatcher::Run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        if (pendingNum_ == 0) {
+            condition_.wait(lock, [this] { return !running_ || pendingNum_ > 0; });
+            continue;
+        }
+        auto dueTime = std::chrono::steady_clock::time_point::max();
+        for (const auto &iter : states_) {
+            if (iter.second.hasPending && iter.second.lastSendTime + MIN_INTERVAL < dueTime) {
+                dueTime = iter.second.lastSendTime + MIN_INTERVAL;
+            }
+        }
+        // Woken early by a new pending tip or EndSchedule, the due time is worked out again.
+        condition_.wait_until(lock, dueTime);
+        if (!running_) {
+            break;
+        }
+        std::vector<Delivery> deliveries;
+        CollectDueLocked(std::chrono::steady_clock::now(), deliveries);
+        if (deliveries.empty()) {
+            continue;
+        }
+        lock.unlock();
+        for (auto &delivery : deliveries) {
+            Deliver(delivery);
+        }
+        lock.lock();
+    }
+}
+} // namespace CoAuth
+} // namespace UserIAM
+} // namespace OHOS
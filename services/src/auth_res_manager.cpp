@@ -16,6 +16,7 @@
 #include "auth_res_manager.h"
 #include <cinttypes>
 #include "executor_messenger.h"
+#include "executor_prop_cache.h"
 
 namespace OHOS {
 namespace UserIAM {
@@ -60,6 +61,7 @@ uint64_t AuthResManager::Register(std::shared_ptr<ResAuthExecutor> executorInfo,
         return INVALID_EXECUTOR_ID;
     }
     coAuthResPool_.Insert(executorId, executorInfo, callback);
+    ExecutorPropCache::GetInstance().Invalidate(info.authType);
 
     // Assign messenger
     sptr<UserIAM::AuthResPool::IExecutorMessenger> messenger =
@@ -108,6 +110,7 @@ int32_t AuthResManager::FindExecutorCallback(uint32_t authType,
 
 int32_t AuthResManager::DeleteExecutorCallback(uint64_t executorID)
 {
+    ExecutorPropCache::GetInstance().InvalidateAll();
     return coAuthResPool_.DeleteExecutorCallback(executorID);
 }
 
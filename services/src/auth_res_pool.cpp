@@ -15,6 +15,7 @@
 
 #include "auth_res_pool.h"
 #include <cinttypes>
+#include "acquire_info_dispatcher.h"
 #include "coauth_info_define.h"
 
 namespace OHOS {
@@ -143,13 +144,17 @@ int32_t AuthResPool::GetScheduleCount(uint64_t scheduleId, uint64_t &scheduleCou
 
 int32_t AuthResPool::DeleteScheduleCallback(uint64_t scheduleId)
 {
-    std::lock_guard<std::mutex> lock(scheMutex_);
-    std::map<uint64_t, std::shared_ptr<ScheduleRegister>>::iterator iter = scheResPool_.find(scheduleId);
-    if (iter == scheResPool_.end()) {
-        COAUTH_HILOGE(MODULE_SERVICE, "scheduleId is not found and delete callback failed");
-        return FAIL;
+    {
+        std::lock_guard<std::mutex> lock(scheMutex_);
+        std::map<uint64_t, std::shared_ptr<ScheduleRegister>>::iterator iter = scheResPool_.find(scheduleId);
+        if (iter == scheResPool_.end()) {
+            COAUTH_HILOGE(MODULE_SERVICE, "scheduleId is not found and delete callback failed");
+            return FAIL;
+        }
+        scheResPool_.erase(iter);
     }
-    scheResPool_.erase(iter);
+    // Outside scheMutex_, ending the schedule may wait for a tip being sent.
+    AcquireInfoDispatcher::GetInstance().EndSchedule(scheduleId);
     COAUTH_HILOGD(MODULE_SERVICE, "delete schedule callback success");
     return SUCCESS;
 }
@@ -14,46 +14,130 @@
  */
 
 #include "call_monitor.h"
-#include "inner_event.h"
-#include "event_runner.h"
+#include <algorithm>
+#include <cinttypes>
 
 namespace OHOS {
 namespace UserIAM {
 namespace CoAuth {
-CallMonitor::CallMonitor()
+namespace {
+constexpr uint32_t WHEEL_SLOT_NUM = 512;
+constexpr int64_t WHEEL_TICK_MS = 100;
+}
+
+CallMonitor::CallMonitor() : slots_(WHEEL_SLOT_NUM)
 {
-    std::shared_ptr<AppExecFwk::EventRunner> runner = AppExecFwk::EventRunner::Create(true);
-    if (runner == nullptr) {
-        COAUTH_HILOGE(MODULE_SERVICE, "runner is nullptr");
-        return;
-    }
-    runner->Run();
-    eventHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    thread_ = std::thread(&CallMonitor::Run, this);
 }
 
-CallMonitor::~CallMonitor() = default;
+CallMonitor::~CallMonitor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    condition_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
 
 void CallMonitor::MonitorCall(int64_t waitTime, uint64_t scheduleId, Callback &timeoutFun)
 {
-    if (eventHandler_ == nullptr) {
-        COAUTH_HILOGE(MODULE_SERVICE, "eventHandler_ is nullptr");
-        return;
+    COAUTH_HILOGI(MODULE_SERVICE, "CallMonitor MonitorCall is called, scheduleId is XXXX%{public}4" PRIx64,
+        scheduleId);
+    auto now = std::chrono::steady_clock::now();
+    bool wasIdle;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        RemoveTimerLocked(scheduleId);
+        wasIdle = timers_.empty();
+        if (wasIdle) {
+            nextTick_ = now + std::chrono::milliseconds(WHEEL_TICK_MS);
+        }
+        // The timer fires on the first tick at or after now + waitTime. Ticks are counted from nextTick_, which is
+        // less than one tick away, so that a timeout never fires before waitTime has passed.
+        std::chrono::steady_clock::duration tick = std::chrono::milliseconds(WHEEL_TICK_MS);
+        auto lateness = now + std::chrono::milliseconds(std::max<int64_t>(waitTime, 0)) - nextTick_;
+        uint64_t ticks = 1;
+        if (lateness.count() > 0) {
+            ticks += static_cast<uint64_t>((lateness.count() + tick.count() - 1) / tick.count());
+        }
+        uint32_t slot = static_cast<uint32_t>((currentSlot_ + ticks) % WHEEL_SLOT_NUM);
+        auto &slotList = slots_[slot];
+        slotList.push_front(scheduleId);
+        timers_[scheduleId] = { (ticks - 1) / WHEEL_SLOT_NUM, slot, slotList.begin(), timeoutFun };
+    }
+    if (wasIdle) {
+        condition_.notify_one();
     }
-    std::string name = std::to_string(scheduleId);
-    COAUTH_HILOGI(MODULE_SERVICE, "CallMonitor MonitorCall is called, name is %{public}s", name.c_str());
-    eventHandler_->PostHighPriorityTask(timeoutFun, name, waitTime);
 }
 
 void CallMonitor::MonitorRemoveCall(uint64_t scheduleId)
 {
-    if (eventHandler_ == nullptr) {
-        COAUTH_HILOGE(MODULE_SERVICE, "eventHandler_ is nullptr");
+    COAUTH_HILOGI(MODULE_SERVICE, "CallMonitor MonitorRemoveCall is called, scheduleId is XXXX%{public}4" PRIx64,
+        scheduleId);
+    std::lock_guard<std::mutex> lock(mutex_);
+    RemoveTimerLocked(scheduleId);
+}
+
+void CallMonitor::RemoveTimerLocked(uint64_t scheduleId)
+{
+    auto iter = timers_.find(scheduleId);
+    if (iter == timers_.end()) {
         return;
     }
-    std::string name = std::to_string(scheduleId);
-    COAUTH_HILOGI(MODULE_SERVICE, "CallMonitor MonitorRemoveCall is called, name is %{public}s", name.c_str());
-    eventHandler_->RemoveTask(name);
+    slots_[iter->second.slot].erase(iter->second.position);
+    timers_.erase(iter);
+}
+
+void CallMonitor::CollectExpiredLocked(std::vector<Callback> &expired)
+{
+    currentSlot_ = (currentSlot_ + 1) % WHEEL_SLOT_NUM;
+    auto &slotList = slots_[currentSlot_];
+    for (auto position = slotList.begin(); position != slotList.end();) {
+        auto iter = timers_.find(*position);
+        if (iter->second.rounds > 0) {
+            iter->second.rounds--;
+            ++position;
+            continue;
+        }
+        expired.push_back(std::move(iter->second.timeoutFun));
+        timers_.erase(iter);
+        position = slotList.erase(position);
+    }
+}
+
+void CallMonitor::Run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        if (timers_.empty()) {
+            condition_.wait(lock, [this] { return !running_ || !timers_.empty(); });
+            continue;
+        }
+        if (condition_.wait_until(lock, nextTick_, [this] { return !running_; })) {
+            break;
+        }
+        std::vector<Callback> expired;
+        auto now = std::chrono::steady_clock::now();
+        // Catch up on ticks missed while the thread was descheduled.
+        while (nextTick_ <= now) {
+            CollectExpiredLocked(expired);
+            nextTick_ += std::chrono::milliseconds(WHEEL_TICK_MS);
+        }
+        if (expired.empty()) {
+            continue;
+        }
+        lock.unlock();
+        for (auto &timeoutFun : expired) {
+            if (timeoutFun != nullptr) {
+                timeoutFun();
+            }
+        }
+        lock.lock();
+    }
 }
-} // namespace PinAuth
+} // namespace CoAuth
 } // namespace UserIAM
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -14,8 +14,9 @@
  */
 
 #include "coauth_manager.h"
-#include "inner_event.h"
+#include "acquire_info_dispatcher.h"
 #include "coauth_thread_pool.h"
+#include "executor_prop_cache.h"
 
 namespace OHOS {
 namespace UserIAM {
@@ -58,15 +59,19 @@ void CoAuthManager::CoAuthHandle(uint64_t scheduleId, AuthInfo &authInfo, sptr<I
         COAUTH_HILOGW(MODULE_SERVICE, "save schedule callback failed");
         return callback->OnFinish(saveRet, scheduleToken);
     }
-    OHOS::AppExecFwk::InnerEvent::Callback task = std::bind(&CoAuthManager::TimeOut, this, scheduleId);
-    CallMonitor::GetInstance().MonitorCall(delay_time, scheduleId, task);
+    AcquireInfoDispatcher::GetInstance().Begin(scheduleId, callback);
+    Callback task = std::bind(&CoAuthManager::TimeOut, this, scheduleId);
+    int64_t timeout = ScheduleTimeoutPolicy::GetInstance().BeginSchedule(scheduleId, scheduleInfo);
+    CallMonitor::GetInstance().MonitorCall(timeout, scheduleId, task);
     BeginExecute(scheduleInfo, executorNum, scheduleId, authInfo, executeRet);
 
     if (executeRet != SUCCESS) {
         COAUTH_HILOGW(MODULE_SERVICE, "there are one or more failures in execution");
+        AcquireInfoDispatcher::GetInstance().EndSchedule(scheduleId);
         callback->OnFinish(executeRet, scheduleToken);
         coAuthResMgrPtr_->DeleteScheduleCallback(scheduleId);
         CallMonitor::GetInstance().MonitorRemoveCall(scheduleId);
+        ScheduleTimeoutPolicy::GetInstance().EndSchedule(scheduleId);
     }
 }
 
@@ -118,9 +123,7 @@ void CoAuthManager::SetAuthAttributes(std::shared_ptr<ResAuthAttributes> command
 /* Cancel collaborative schedule */
 int32_t CoAuthManager::Cancel(uint64_t scheduleId)
 {
-    int32_t executeRet = SUCCESS;
     ScheduleInfo scheduleInfo;
-    sptr<ResIExecutorCallback> callback = nullptr;
     int32_t getRet = GetScheduleInfo(scheduleId, scheduleInfo); // call TA
     if (getRet != SUCCESS) {
         COAUTH_HILOGE(MODULE_SERVICE, "get shedule info filed");
@@ -145,21 +148,14 @@ int32_t CoAuthManager::Cancel(uint64_t scheduleId)
         commandAttrs->SetUint32Value(AUTH_SCHEDULE_MODE, scheduleInfo.scheduleMode);
         commandAttrs->SetUint64Value(AUTH_SUBTYPE, scheduleInfo.authSubType);
         commandAttrs->SetUint64Value(AUTH_TEMPLATE_ID, scheduleInfo.templateId);
-        onceRet = executorCallback->OnEndExecute(scheduleId, commandAttrs);
-        if (onceRet != SUCCESS) {
-            COAUTH_HILOGE(MODULE_SERVICE, "executor i = %{public}zu failed", i);
-            executeRet = onceRet;
-        }
-    }
-    if (executeRet != SUCCESS) {
-        COAUTH_HILOGW(MODULE_SERVICE, "there are one or more failures when canceling");
-        return executeRet;
+        // The schedule is dropped whatever the executor answers, so do not wait for it.
+        executorCallback->OnCancelExecute(scheduleId, commandAttrs);
     }
     int32_t deleteRet = DeleteScheduleInfo(scheduleId, scheduleInfo); // call TA
     if (deleteRet != SUCCESS) {
         COAUTH_HILOGW(MODULE_SERVICE, "delete schedule info failed, ret = %{public}d", deleteRet);
     }
-    return executeRet;
+    return SUCCESS;
 }
 
 /* Set executor properties */
@@ -186,10 +182,9 @@ void CoAuthManager::SetExecutorProp(ResAuthAttributes &conditions, sptr<ISetProp
         COAUTH_HILOGE(MODULE_SERVICE, "executor callback not found");
         return callback->OnResult(result, extraInfo);
     }
-    std::vector<uint8_t> buffer;
-    std::shared_ptr<ResAuthAttributes> properties = std::make_shared<ResAuthAttributes>();
-    conditions.Pack(buffer);
-    properties->Unpack(buffer);
+    // The executor proxy encodes the copy again, so only the values read by the stub reach the executor.
+    std::shared_ptr<ResAuthAttributes> properties = std::make_shared<ResAuthAttributes>(conditions);
+    ExecutorPropCache::GetInstance().Invalidate(authType);
     result = static_cast<uint32_t>(execallback->OnSetProperty(properties));
     if (result != SUCCESS) {
         COAUTH_HILOGE(MODULE_SERVICE, "set properties failed");
@@ -210,21 +205,157 @@ int32_t CoAuthManager::GetExecutorProp(ResAuthAttributes &conditions, std::share
         return FAIL;
     }
     std::vector<uint8_t> buffer;
-    std::shared_ptr<ResAuthAttributes> properties = std::make_shared<ResAuthAttributes>();
+    conditions.Pack(buffer);
+    if (ExecutorPropCache::GetInstance().Find(conditions, buffer, values)) {
+        return SUCCESS;
+    }
+    std::shared_ptr<ResAuthAttributes> properties = std::make_shared<ResAuthAttributes>(conditions);
     if (properties == nullptr) {
         COAUTH_HILOGE(MODULE_SERVICE, "properties is nullptr");
         return FAIL;
     }
-    conditions.Pack(buffer);
-    properties->Unpack(buffer);
     retCode = execallback->OnGetProperty(properties, values);
     if (retCode != SUCCESS) {
         COAUTH_HILOGE(MODULE_SERVICE, "get properties failed");
+    } else {
+        ExecutorPropCache::GetInstance().Save(conditions, buffer, values);
     }
     COAUTH_HILOGI(MODULE_SERVICE, "get properties end");
     return retCode;
 }
 
+/* Batched GetExecutorProp, each executor gets the conditions of its authType in one call */
+int32_t CoAuthManager::GetExecutorProps(std::vector<std::shared_ptr<ResAuthAttributes>> &conditions,
+    std::vector<std::shared_ptr<ResAuthAttributes>> &values, std::vector<int32_t> &results)
+{
+    if (conditions.size() > MAX_PROPERTY_BATCH_NUM) {
+        COAUTH_HILOGE(MODULE_SERVICE, "too many conditions");
+        return INVALID_PARAMETERS;
+    }
+    values.clear();
+    results.assign(conditions.size(), FAIL);
+    std::map<uint32_t, std::vector<std::size_t>> indexesByType;
+    for (std::size_t i = 0; i < conditions.size(); i++) {
+        values.push_back(std::make_shared<ResAuthAttributes>());
+        if (conditions[i] == nullptr) {
+            continue;
+        }
+        std::vector<uint8_t> buffer;
+        conditions[i]->Pack(buffer);
+        if (ExecutorPropCache::GetInstance().Find(*conditions[i], buffer, values[i])) {
+            results[i] = SUCCESS;
+            continue;
+        }
+        uint32_t authType = 0;
+        conditions[i]->GetUint32Value(AUTH_TYPE, authType);
+        indexesByType[authType].push_back(i);
+    }
+    for (const auto &iter : indexesByType) {
+        GetExecutorPropsByType(iter.first, iter.second, conditions, values, results);
+    }
+    return SUCCESS;
+}
+
+void CoAuthManager::GetExecutorPropsByType(uint32_t authType, const std::vector<std::size_t> &indexes,
+    std::vector<std::shared_ptr<ResAuthAttributes>> &conditions,
+    std::vector<std::shared_ptr<ResAuthAttributes>> &values, std::vector<int32_t> &results)
+{
+    sptr<ResIExecutorCallback> execallback = nullptr;
+    coAuthResMgrPtr_->FindExecutorCallback(authType, execallback);
+    if (execallback == nullptr) {
+        COAUTH_HILOGE(MODULE_SERVICE, "executor callback not found, authType is %{public}u", authType);
+        return;
+    }
+    std::vector<std::shared_ptr<ResAuthAttributes>> typeConditions;
+    for (std::size_t index : indexes) {
+        typeConditions.push_back(conditions[index]);
+    }
+    std::vector<std::shared_ptr<ResAuthAttributes>> typeValues;
+    std::vector<int32_t> typeResults;
+    int32_t ret = execallback->OnGetProperties(typeConditions, typeValues, typeResults);
+    if (ret == ResIExecutorCallback::BATCH_NOT_SUPPORT) {
+        // Executors built before the batch call reject it, ask them one condition at a time.
+        COAUTH_HILOGW(MODULE_SERVICE, "batch call is not supported, get properties one by one");
+        typeValues.clear();
+        typeResults.clear();
+        for (auto &condition : typeConditions) {
+            std::shared_ptr<ResAuthAttributes> value = std::make_shared<ResAuthAttributes>();
+            typeResults.push_back(execallback->OnGetProperty(condition, value));
+            typeValues.push_back(value);
+        }
+    } else if (ret != SUCCESS) {
+        // The results keep FAIL, asking again one by one would only repeat the failed work.
+        COAUTH_HILOGE(MODULE_SERVICE, "get properties failed, ret is %{public}d", ret);
+        return;
+    }
+    for (std::size_t i = 0; i < indexes.size(); i++) {
+        std::size_t index = indexes[i];
+        results[index] = typeResults[i];
+        values[index] = typeValues[i];
+        if (results[index] == SUCCESS) {
+            std::vector<uint8_t> buffer;
+            conditions[index]->Pack(buffer);
+            ExecutorPropCache::GetInstance().Save(*conditions[index], buffer, values[index]);
+        }
+    }
+}
+
+/* Batched SetExecutorProp, each executor gets the properties of its authType in one call */
+int32_t CoAuthManager::SetExecutorProps(std::vector<std::shared_ptr<ResAuthAttributes>> &conditions,
+    std::vector<int32_t> &results)
+{
+    if (conditions.size() > MAX_PROPERTY_BATCH_NUM) {
+        COAUTH_HILOGE(MODULE_SERVICE, "too many conditions");
+        return INVALID_PARAMETERS;
+    }
+    results.assign(conditions.size(), FAIL);
+    std::map<uint32_t, std::vector<std::size_t>> indexesByType;
+    for (std::size_t i = 0; i < conditions.size(); i++) {
+        if (conditions[i] == nullptr) {
+            continue;
+        }
+        uint32_t authType = 0;
+        conditions[i]->GetUint32Value(AUTH_TYPE, authType);
+        indexesByType[authType].push_back(i);
+    }
+    for (const auto &iter : indexesByType) {
+        SetExecutorPropsByType(iter.first, iter.second, conditions, results);
+    }
+    return SUCCESS;
+}
+
+void CoAuthManager::SetExecutorPropsByType(uint32_t authType, const std::vector<std::size_t> &indexes,
+    std::vector<std::shared_ptr<ResAuthAttributes>> &conditions, std::vector<int32_t> &results)
+{
+    sptr<ResIExecutorCallback> execallback = nullptr;
+    coAuthResMgrPtr_->FindExecutorCallback(authType, execallback);
+    if (execallback == nullptr) {
+        COAUTH_HILOGE(MODULE_SERVICE, "executor callback not found, authType is %{public}u", authType);
+        return;
+    }
+    ExecutorPropCache::GetInstance().Invalidate(authType);
+    std::vector<std::shared_ptr<ResAuthAttributes>> typeConditions;
+    for (std::size_t index : indexes) {
+        typeConditions.push_back(conditions[index]);
+    }
+    std::vector<int32_t> typeResults;
+    int32_t ret = execallback->OnSetProperties(typeConditions, typeResults);
+    if (ret == ResIExecutorCallback::BATCH_NOT_SUPPORT) {
+        COAUTH_HILOGW(MODULE_SERVICE, "batch call is not supported, set properties one by one");
+        typeResults.clear();
+        for (auto &condition : typeConditions) {
+            typeResults.push_back(execallback->OnSetProperty(condition));
+        }
+    } else if (ret != SUCCESS) {
+        // The executor may have applied some of the properties, setting them again could repeat a change.
+        COAUTH_HILOGE(MODULE_SERVICE, "set properties failed, ret is %{public}d", ret);
+        return;
+    }
+    for (std::size_t i = 0; i < indexes.size(); i++) {
+        results[indexes[i]] = typeResults[i];
+    }
+}
+
 void CoAuthManager::RegistResourceManager(AuthResManager* resMgr)
 {
     coAuthResMgrPtr_ = resMgr;
@@ -257,8 +388,11 @@ void CoAuthManager::TimeOut(uint64_t scheduleId)
     int32_t findRet = coAuthResMgrPtr_->FindScheduleCallback(scheduleId, callback);
     if (findRet != SUCCESS || callback == nullptr) {
         COAUTH_HILOGD(MODULE_SERVICE, "Schedule has ended");
+        ScheduleTimeoutPolicy::GetInstance().EndSchedule(scheduleId);
         return;
     }
+    ScheduleTimeoutPolicy::GetInstance().TimeoutSchedule(scheduleId);
+    AcquireInfoDispatcher::GetInstance().EndSchedule(scheduleId);
     std::vector<uint8_t> scheduleToken;
     callback->OnFinish(TIMEOUT, scheduleToken);
     Cancel(scheduleId);
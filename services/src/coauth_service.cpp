@@ -19,6 +19,7 @@
 #include <string_ex.h>
 #include <if_system_ability_manager.h>
 #include <iservice_registry.h>
+#include <cstdio>
 #include <unistd.h>
 #include <thread>
 #include "useriam_common.h"
@@ -56,6 +57,7 @@ void CoAuthService::OnStart()
         return;
     }
     state_ = CoAuthRunningState::STATE_RUNNING;
+    ScheduleTimeoutPolicy::GetInstance().LoadConfig(SCHEDULE_TIMEOUT_CONFIG_PATH);
 
     if (!Common::IsIAMInited()) {
         if (Common::Init() != SUCCESS) {
@@ -91,6 +93,27 @@ void CoAuthService::OnStop()
     COAUTH_HILOGI(MODULE_SERVICE, "Stop service");
 }
 
+/* Dump service state, "-m" or no argument dumps the memory statistics of the common lib. */
+int CoAuthService::Dump(int fd, const std::vector<std::u16string> &args)
+{
+    if (fd < 0) {
+        COAUTH_HILOGE(MODULE_SERVICE, "invalid dump fd");
+        return FAIL;
+    }
+    std::string info;
+    std::string option = args.empty() ? "-m" : Str16ToStr8(args[0]);
+    if (option == "-m") {
+        Common::GetMemoryDumpInfo(info);
+    } else {
+        info.append("usage:\n  -h: show this help\n  -m: dump memory statistics\n");
+    }
+    if (dprintf(fd, "%s", info.c_str()) < 0) {
+        COAUTH_HILOGE(MODULE_SERVICE, "write dump info failed");
+        return FAIL;
+    }
+    return SUCCESS;
+}
+
 /* Register the executor, pass in the executor information and the callback returns the executor ID. */
 uint64_t CoAuthService::Register(std::shared_ptr<ResAuthExecutor> executorInfo,
                                  const sptr<ResIExecutorCallback> &callback)
@@ -110,6 +133,21 @@ uint64_t CoAuthService::Register(std::shared_ptr<ResAuthExecutor> executorInfo,
     return exeID;
 }
 
+/* Register several executors, used by executor processes to come back after the service restarts */
+int32_t CoAuthService::RegisterMany(std::vector<std::shared_ptr<ResAuthExecutor>> &executorInfos,
+    std::vector<sptr<ResIExecutorCallback>> &callbacks, std::vector<uint64_t> &executorIds)
+{
+    if (executorInfos.size() != callbacks.size() || executorInfos.size() > MAX_REGISTER_BATCH_NUM) {
+        COAUTH_HILOGE(MODULE_SERVICE, "executorInfos and callbacks do not match");
+        return INVALID_PARAMETERS;
+    }
+    executorIds.clear();
+    for (std::size_t i = 0; i < executorInfos.size(); i++) {
+        executorIds.push_back(authResMgr_.Register(executorInfos[i], callbacks[i]));
+    }
+    return SUCCESS;
+}
+
 /* Query whether the executor is registered */
 void CoAuthService::QueryStatus(ResAuthExecutor &executorInfo, const sptr<ResIQueryCallback> &callback)
 {
@@ -155,6 +193,20 @@ int32_t CoAuthService::GetExecutorProp(ResAuthAttributes &conditions, std::share
     }
     return coAuthMgr_.GetExecutorProp(conditions, values);
 }
+
+/* Get executor properties in batch */
+int32_t CoAuthService::GetExecutorProps(std::vector<std::shared_ptr<ResAuthAttributes>> &conditions,
+    std::vector<std::shared_ptr<ResAuthAttributes>> &values, std::vector<int32_t> &results)
+{
+    return coAuthMgr_.GetExecutorProps(conditions, values, results);
+}
+
+/* Set executor properties in batch */
+int32_t CoAuthService::SetExecutorProps(std::vector<std::shared_ptr<ResAuthAttributes>> &conditions,
+    std::vector<int32_t> &results)
+{
+    return coAuthMgr_.SetExecutorProps(conditions, results);
+}
 } // namespace CoAu
 } // namespace UserIAM
 } // namespace OHOS
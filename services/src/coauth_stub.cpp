@@ -47,6 +47,12 @@ int32_t CoAuthStub::OnRemoteRequest(uint32_t code, MessageParcel &data,
             return GetExecutorPropStub(data, reply);
         case static_cast<int32_t>(ICoAuth::COAUTH_SET_PROPERTY):
             return SetExecutorPropStub(data, reply);
+        case static_cast<int32_t>(ICoAuth::COAUTH_GET_PROPERTIES):
+            return GetExecutorPropsStub(data, reply);
+        case static_cast<int32_t>(ICoAuth::COAUTH_SET_PROPERTIES):
+            return SetExecutorPropsStub(data, reply);
+        case static_cast<int32_t>(ICoAuth::COAUTH_EXECUTOR_REGIST_MANY):
+            return RegisterManyStub(data, reply);
         default:
             return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
     }
@@ -96,6 +102,36 @@ int32_t CoAuthStub::RegisterStub(MessageParcel& data, MessageParcel& reply)
     return SUCCESS;
 }
 
+int32_t CoAuthStub::RegisterManyStub(MessageParcel& data, MessageParcel& reply)
+{
+    uint32_t num = 0;
+    if (!data.ReadUint32(num) || num > MAX_REGISTER_BATCH_NUM) {
+        COAUTH_HILOGE(MODULE_SERVICE, "read executor num failed");
+        return FAIL;
+    }
+    std::vector<std::shared_ptr<AuthResPool::AuthExecutor>> executorInfos;
+    std::vector<sptr<AuthResPool::IExecutorCallback>> callbacks;
+    for (uint32_t i = 0; i < num; i++) {
+        std::shared_ptr<AuthResPool::AuthExecutor> executorInfo = std::make_shared<AuthResPool::AuthExecutor>();
+        ReadAuthExecutor(*executorInfo, data);
+        sptr<AuthResPool::IExecutorCallback> callback =
+            iface_cast<AuthResPool::IExecutorCallback>(data.ReadRemoteObject());
+        if (callback == nullptr) {
+            COAUTH_HILOGE(MODULE_SERVICE, "read IExecutorCallback is nullptr");
+            return FAIL;
+        }
+        executorInfos.push_back(executorInfo);
+        callbacks.push_back(callback);
+    }
+    std::vector<uint64_t> executorIds;
+    int32_t ret = RegisterMany(executorInfos, callbacks, executorIds);
+    if (!reply.WriteInt32(ret) || !reply.WriteUInt64Vector(executorIds)) {
+        COAUTH_HILOGE(MODULE_SERVICE, "write reply failed");
+        return FAIL;
+    }
+    return SUCCESS;
+}
+
 int32_t CoAuthStub::QueryStatusStub(MessageParcel& data, MessageParcel& reply)
 {
     AuthResPool::AuthExecutor executorInfo;
@@ -196,6 +232,42 @@ int32_t CoAuthStub::SetExecutorPropStub(MessageParcel& data, MessageParcel& repl
 
     return SUCCESS;
 }
+
+int32_t CoAuthStub::GetExecutorPropsStub(MessageParcel& data, MessageParcel& reply)
+{
+    COAUTH_HILOGI(MODULE_SERVICE, "CoAuthStub: GetExecutorPropsStub start");
+    std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> conditions;
+    if (!AuthResPool::AuthAttributes::ReadAttributesList(data, conditions)) {
+        COAUTH_HILOGE(MODULE_SERVICE, "read conditions failed");
+        return FAIL;
+    }
+    std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> values;
+    std::vector<int32_t> results;
+    int32_t ret = GetExecutorProps(conditions, values, results);
+    if (!reply.WriteInt32(ret) || !reply.WriteInt32Vector(results) ||
+        !AuthResPool::AuthAttributes::WriteAttributesList(reply, values)) {
+        COAUTH_HILOGE(MODULE_SERVICE, "write reply failed");
+        return FAIL;
+    }
+    return SUCCESS;
+}
+
+int32_t CoAuthStub::SetExecutorPropsStub(MessageParcel& data, MessageParcel& reply)
+{
+    COAUTH_HILOGI(MODULE_SERVICE, "CoAuthStub: SetExecutorPropsStub start");
+    std::vector<std::shared_ptr<AuthResPool::AuthAttributes>> conditions;
+    if (!AuthResPool::AuthAttributes::ReadAttributesList(data, conditions)) {
+        COAUTH_HILOGE(MODULE_SERVICE, "read conditions failed");
+        return FAIL;
+    }
+    std::vector<int32_t> results;
+    int32_t ret = SetExecutorProps(conditions, results);
+    if (!reply.WriteInt32(ret) || !reply.WriteInt32Vector(results)) {
+        COAUTH_HILOGE(MODULE_SERVICE, "write reply failed");
+        return FAIL;
+    }
+    return SUCCESS;
+}
 } // namespace CoAuth
 } // namespace UserIAM
 } // namespace OHOS
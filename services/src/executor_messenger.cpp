@@ -16,7 +16,10 @@
 #include "executor_messenger.h"
 #include "securec.h"
 #include "coauth_interface.h"
+#include "acquire_info_dispatcher.h"
 #include "call_monitor.h"
+#include "executor_prop_cache.h"
+#include "schedule_timeout_policy.h"
 
 namespace OHOS {
 namespace UserIAM {
@@ -34,28 +37,24 @@ int32_t ExecutorMessenger::SendData(uint64_t scheduleId, uint64_t transNum, int3
         return FAIL;
     }
 
-    sptr<UserIAM::CoAuth::ICoAuthCallback> callback;
-    int32_t findRet = ScheResPool_->FindScheduleCallback(scheduleId, callback);
-    if (findRet != SUCCESS || callback == nullptr) {
-        COAUTH_HILOGE(MODULE_SERVICE, "ScheduleCallback not find");
-        return FAIL;
-    }
-
     std::vector<uint8_t> message;
     msg->FromUint8Array(message);
-    if (message.size() != sizeof(uint32_t)) {
+    if (message.size() < sizeof(uint32_t) || message.size() > sizeof(uint32_t) + MAX_ACQUIRE_EXTRA_INFO_LEN) {
         COAUTH_HILOGE(MODULE_SERVICE, "message size not right");
         return FAIL;
     }
 
-    // trans to acquireCode
+    // trans to acquireCode, the bytes after it are passed on as extra info
     uint32_t acquire = 0;
-    if (memcpy_s(&acquire, sizeof(uint32_t), message.data(), message.size()) != EOK) {
+    if (memcpy_s(&acquire, sizeof(uint32_t), message.data(), sizeof(uint32_t)) != EOK) {
         COAUTH_HILOGE(MODULE_SERVICE, "message copy not right");
         return FAIL;
     }
-    callback->OnAcquireInfo(acquire);
-    COAUTH_HILOGD(MODULE_SERVICE, "feedback acquire info");
+    std::vector<uint8_t> extraInfo(message.begin() + sizeof(uint32_t), message.end());
+    if (!UserIAM::CoAuth::AcquireInfoDispatcher::GetInstance().Dispatch(scheduleId, acquire, extraInfo)) {
+        COAUTH_HILOGE(MODULE_SERVICE, "schedule is not running");
+        return FAIL;
+    }
     return SUCCESS;
 }
 
@@ -96,6 +95,7 @@ int32_t ExecutorMessenger::Finish(uint64_t scheduleId, int32_t srcType, int32_t
 {
     COAUTH_HILOGD(MODULE_SERVICE, "ExecutorMessenger::Finish");
     if (ScheResPool_ == nullptr) {
+        UserIAM::CoAuth::ScheduleTimeoutPolicy::GetInstance().EndSchedule(scheduleId);
         DeleteScheduleInfoById(scheduleId);
         COAUTH_HILOGE(MODULE_SERVICE, "ScheResPool_ is nullptr");
         return FAIL;
@@ -107,6 +107,14 @@ int32_t ExecutorMessenger::Finish(uint64_t scheduleId, int32_t srcType, int32_t
         return SUCCESS;
     }
     UserIAM::CoAuth::CallMonitor::GetInstance().MonitorRemoveCall(scheduleId);
+    UserIAM::CoAuth::AcquireInfoDispatcher::GetInstance().EndSchedule(scheduleId);
+    // Only a successful schedule measures the executor, failures may return at any time.
+    if (resultCode == SUCCESS) {
+        UserIAM::CoAuth::ScheduleTimeoutPolicy::GetInstance().FinishSchedule(scheduleId);
+    } else {
+        UserIAM::CoAuth::ScheduleTimeoutPolicy::GetInstance().EndSchedule(scheduleId);
+    }
+    UserIAM::CoAuth::ExecutorPropCache::GetInstance().InvalidateAll();
     sptr<UserIAM::CoAuth::ICoAuthCallback> callback;
     int32_t findRet = ScheResPool_->FindScheduleCallback(scheduleId, callback);
     if (findRet != SUCCESS || callback == nullptr) {
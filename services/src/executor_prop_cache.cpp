@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "executor_prop_cache.h"
+#include "coauth_hilog_wrapper.h"
+
+namespace OHOS {
+namespace UserIAM {
+namespace CoAuth {
+namespace {
+constexpr int64_t PROP_CACHE_TTL_MS = 5000;
+constexpr size_t MAX_PROP_CACHE_NUM = 64;
+}
+
+ExecutorPropCache::ExecutorPropCache() = default;
+
+ExecutorPropCache::~ExecutorPropCache() = default;
+
+ExecutorPropCache::CacheKey ExecutorPropCache::GetKey(UserIAM::AuthResPool::AuthAttributes &conditions)
+{
+    uint32_t authType = 0;
+    uint64_t templateId = 0;
+    uint32_t propertyMode = 0;
+    conditions.GetUint32Value(AUTH_TYPE, authType);
+    conditions.GetUint64Value(AUTH_TEMPLATE_ID, templateId);
+    conditions.GetUint32Value(AUTH_PROPERTY_MODE, propertyMode);
+    return std::make_tuple(authType, templateId, propertyMode);
+}
+
+bool ExecutorPropCache::Find(UserIAM::AuthResPool::AuthAttributes &conditions,
+    const std::vector<uint8_t> &packedConditions, std::shared_ptr<UserIAM::AuthResPool::AuthAttributes> values)
+{
+#ifdef EXECUTOR_PROP_CACHE
+    if (values == nullptr) {
+        return false;
+    }
+    std::vector<uint8_t> packedValues;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = entries_.find(GetKey(conditions));
+        if (iter == entries_.end()) {
+            return false;
+        }
+        if (iter->second.expireTime <= std::chrono::steady_clock::now()) {
+            entries_.erase(iter);
+            return false;
+        }
+        if (iter->second.conditions != packedConditions) {
+            return false;
+        }
+        packedValues = iter->second.values;
+    }
+    values->Unpack(packedValues);
+    COAUTH_HILOGD(MODULE_SERVICE, "executor property cache hit");
+    return true;
+#else
+    (void)conditions;
+    (void)packedConditions;
+    (void)values;
+    return false;
+#endif
+}
+
+void ExecutorPropCache::Save(UserIAM::AuthResPool::AuthAttributes &conditions,
+    const std::vector<uint8_t> &packedConditions, std::shared_ptr<UserIAM::AuthResPool::AuthAttributes> values)
+{
+#ifdef EXECUTOR_PROP_CACHE
+    if (values == nullptr) {
+        return;
+    }
+    CacheEntry entry;
+    entry.conditions = packedConditions;
+    values->Pack(entry.values);
+    auto now = std::chrono::steady_clock::now();
+    entry.expireTime = now + std::chrono::milliseconds(PROP_CACHE_TTL_MS);
+    CacheKey key = GetKey(conditions);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= MAX_PROP_CACHE_NUM && entries_.find(key) == entries_.end()) {
+        RemoveExpiredLocked(now);
+        if (entries_.size() >= MAX_PROP_CACHE_NUM) {
+            return;
+        }
+    }
+    entries_[key] = std::move(entry);
+#else
+    (void)conditions;
+    (void)packedConditions;
+    (void)values;
+#endif
+}
+
+void ExecutorPropCache::RemoveExpiredLocked(std::chrono::steady_clock::time_point now)
+{
+    for (auto iter = entries_.begin(); iter != entries_.end();) {
+        if (iter->second.expireTime <= now) {
+            iter = entries_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void ExecutorPropCache::Invalidate(uint32_t authType)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto begin = entries_.lower_bound(CacheKey(authType, 0, 0));
+    auto end = entries_.upper_bound(CacheKey(authType, UINT64_MAX, UINT32_MAX));
+    entries_.erase(begin, end);
+}
+
+void ExecutorPropCache::InvalidateAll()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+} // namespace CoAuth
+} // namespace UserIAM
+} // namespace OHOS
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "schedule_timeout_policy.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
+#include "coauth_hilog_wrapper.h"
+
+namespace OHOS {
+namespace UserIAM {
+namespace CoAuth {
+namespace {
+constexpr uint32_t ANY_AUTH_TYPE = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t ANY_SCHEDULE_MODE = std::numeric_limits<uint32_t>::max();
+constexpr uint64_t ANY_EXECUTOR = std::numeric_limits<uint64_t>::max();
+constexpr uint32_t MIN_ADAPTIVE_SAMPLE_NUM = 16;
+constexpr int64_t MIN_ADAPTIVE_TIMEOUT_MS = 30 * 1000;
+constexpr int64_t MAX_ADAPTIVE_TIMEOUT_MS = 600 * 1000;
+constexpr int64_t MAX_CONFIG_TIMEOUT_MS = 3600 * 1000;
+constexpr uint32_t RULE_FIELD_NUM = 4;
+// Smoothed latency and deviation gains of 1/8 and 1/4, the timeout is the average plus four deviations.
+constexpr int64_t AVERAGE_GAIN_SHIFT = 3;
+constexpr int64_t DEVIATION_GAIN_SHIFT = 2;
+constexpr int64_t DEVIATION_FACTOR = 4;
+
+template <typename T>
+bool ParseField(const std::string &field, T anyValue, T &value)
+{
+    if (field == "*") {
+        value = anyValue;
+        return true;
+    }
+    std::istringstream stream(field);
+    uint64_t number = 0;
+    if (!(stream >> number) || !stream.eof() || number >= static_cast<uint64_t>(anyValue)) {
+        return false;
+    }
+    value = static_cast<T>(number);
+    return true;
+}
+}
+
+ScheduleTimeoutPolicy::ScheduleTimeoutPolicy() = default;
+
+ScheduleTimeoutPolicy::~ScheduleTimeoutPolicy() = default;
+
+bool ScheduleTimeoutPolicy::ParseRule(const std::string &line, RuleKey &key, int64_t &timeout)
+{
+    std::istringstream stream(line);
+    std::vector<std::string> fields;
+    std::string field;
+    while (stream >> field) {
+        fields.push_back(field);
+    }
+    if (fields.size() != RULE_FIELD_NUM) {
+        return false;
+    }
+    uint32_t authType = 0;
+    uint32_t scheduleMode = 0;
+    uint64_t executorId = 0;
+    uint64_t timeoutMs = 0;
+    if (!ParseField(fields[0], ANY_AUTH_TYPE, authType) ||
+        !ParseField(fields[1], ANY_SCHEDULE_MODE, scheduleMode) ||
+        !ParseField(fields[2], ANY_EXECUTOR, executorId) ||
+        !ParseField(fields[3], std::numeric_limits<uint64_t>::max(), timeoutMs)) {
+        return false;
+    }
+    if (timeoutMs == 0 || timeoutMs > MAX_CONFIG_TIMEOUT_MS) {
+        return false;
+    }
+    if (authType == ANY_AUTH_TYPE && (scheduleMode != ANY_SCHEDULE_MODE || executorId != ANY_EXECUTOR)) {
+        return false;
+    }
+    key = std::make_tuple(authType, scheduleMode, executorId);
+    timeout = static_cast<int64_t>(timeoutMs);
+    return true;
+}
+
+bool ScheduleTimeoutPolicy::LoadConfig(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        COAUTH_HILOGI(MODULE_SERVICE, "no schedule timeout config, use default policy");
+        return false;
+    }
+    std::map<RuleKey, int64_t> rules;
+    std::string line;
+    uint32_t lineNum = 0;
+    while (std::getline(file, line)) {
+        lineNum++;
+        std::string content = line.substr(0, line.find('#'));
+        if (content.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        RuleKey key;
+        int64_t timeout = 0;
+        if (!ParseRule(content, key, timeout)) {
+            COAUTH_HILOGE(MODULE_SERVICE, "invalid schedule timeout rule at line %{public}u", lineNum);
+            continue;
+        }
+        rules[key] = timeout;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    rules_.swap(rules);
+    COAUTH_HILOGI(MODULE_SERVICE, "load %{public}zu schedule timeout rules", rules_.size());
+    return true;
+}
+
+bool ScheduleTimeoutPolicy::FindRuleLocked(const ScheduleInfo &scheduleInfo, int64_t &timeout)
+{
+    if (rules_.empty()) {
+        return false;
+    }
+    uint32_t authType = scheduleInfo.executors.empty() ? ANY_AUTH_TYPE : scheduleInfo.executors[0].authType;
+    for (uint32_t scheduleMode : { scheduleInfo.scheduleMode, ANY_SCHEDULE_MODE }) {
+        // A schedule with several executors takes the longest executor specific timeout.
+        bool found = false;
+        for (const auto &executor : scheduleInfo.executors) {
+            auto iter = rules_.find(std::make_tuple(authType, scheduleMode, executor.executorId));
+            if (iter != rules_.end()) {
+                timeout = found ? std::max(timeout, iter->second) : iter->second;
+                found = true;
+            }
+        }
+        if (found) {
+            return true;
+        }
+        auto iter = rules_.find(std::make_tuple(authType, scheduleMode, ANY_EXECUTOR));
+        if (iter != rules_.end()) {
+            timeout = iter->second;
+            return true;
+        }
+    }
+    auto iter = rules_.find(std::make_tuple(ANY_AUTH_TYPE, ANY_SCHEDULE_MODE, ANY_EXECUTOR));
+    if (iter != rules_.end()) {
+        timeout = iter->second;
+        return true;
+    }
+    return false;
+}
+
+int64_t ScheduleTimeoutPolicy::GetAdaptiveTimeoutLocked(const LatencyKey &key)
+{
+    auto iter = latencies_.find(key);
+    if (iter == latencies_.end() || iter->second.sampleNum < MIN_ADAPTIVE_SAMPLE_NUM) {
+        return delay_time;
+    }
+    int64_t timeout = iter->second.average + DEVIATION_FACTOR * iter->second.deviation;
+    return std::min(std::max(timeout, MIN_ADAPTIVE_TIMEOUT_MS), MAX_ADAPTIVE_TIMEOUT_MS);
+}
+
+void ScheduleTimeoutPolicy::AddSampleLocked(const LatencyKey &key, int64_t latency)
+{
+    auto iter = latencies_.find(key);
+    if (iter == latencies_.end()) {
+        latencies_[key] = { 1, latency, latency / 2 };
+        return;
+    }
+    LatencyStats &stats = iter->second;
+    int64_t error = latency - stats.average;
+    stats.average += error >> AVERAGE_GAIN_SHIFT;
+    stats.deviation += (std::abs(error) - stats.deviation) >> DEVIATION_GAIN_SHIFT;
+    if (stats.sampleNum < std::numeric_limits<uint32_t>::max()) {
+        stats.sampleNum++;
+    }
+}
+
+int64_t ScheduleTimeoutPolicy::BeginSchedule(uint64_t scheduleId, const ScheduleInfo &scheduleInfo)
+{
+    uint32_t authType = scheduleInfo.executors.empty() ? ANY_AUTH_TYPE : scheduleInfo.executors[0].authType;
+    LatencyKey key = std::make_pair(authType, scheduleInfo.scheduleMode);
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t timeout = 0;
+    if (!FindRuleLocked(scheduleInfo, timeout)) {
+        timeout = GetAdaptiveTimeoutLocked(key);
+    }
+    running_[scheduleId] = { key, timeout, std::chrono::steady_clock::now() };
+    COAUTH_HILOGD(MODULE_SERVICE, "schedule timeout is %{public}lld ms", static_cast<long long>(timeout));
+    return timeout;
+}
+
+void ScheduleTimeoutPolicy::FinishSchedule(uint64_t scheduleId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = running_.find(scheduleId);
+    if (iter == running_.end()) {
+        return;
+    }
+    auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - iter->second.begin).count();
+    AddSampleLocked(iter->second.key, static_cast<int64_t>(latency));
+    running_.erase(iter);
+}
+
+void ScheduleTimeoutPolicy::TimeoutSchedule(uint64_t scheduleId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = running_.find(scheduleId);
+    if (iter == running_.end()) {
+        return;
+    }
+    AddSampleLocked(iter->second.key, iter->second.timeout);
+    running_.erase(iter);
+}
+
+void ScheduleTimeoutPolicy::EndSchedule(uint64_t scheduleId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_.erase(scheduleId);
+}
+} // namespace CoAuth
+} // namespace UserIAM
+} // namespace OHOS
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+extern "C" {
+#include "adaptor_algorithm.h"
+#include "adaptor_crypto.h"
+#include "buffer.h"
+}
+
+namespace OHOS {
+namespace UserIAM {
+namespace {
+constexpr uint32_t TOKEN_DATA_LEN = 64;
+constexpr uint32_t EXECUTOR_MSG_LEN = 256;
+constexpr uint32_t HMAC_LEN = 32;
+
+// Each benchmark runs once per provider type, add new backends here to compare them.
+const CryptoProviderType PROVIDER_TYPES[] = { DEFAULT_CRYPTO_PROVIDER };
+
+bool UseProvider(benchmark::State &state)
+{
+    CryptoProvider *provider = GetCryptoProvider(static_cast<CryptoProviderType>(state.range(0)));
+    if (SetCryptoProvider(provider) != RESULT_SUCCESS) {
+        state.SkipWithError("crypto provider is unavailable");
+        return false;
+    }
+    state.SetLabel(provider->name);
+    return true;
+}
+
+Buffer *CreateRandomBuffer(uint32_t size)
+{
+    Buffer *buffer = CreateBuffer(size);
+    if (buffer == nullptr) {
+        return nullptr;
+    }
+    if (SecureRandom(buffer->buf, size) != RESULT_SUCCESS) {
+        DestoryBuffer(buffer);
+        return nullptr;
+    }
+    buffer->contentSize = size;
+    return buffer;
+}
+
+void BM_HmacSha256(benchmark::State &state)
+{
+    if (!UseProvider(state)) {
+        return;
+    }
+    Buffer *key = CreateRandomBuffer(HMAC_LEN);
+    Buffer *data = CreateRandomBuffer(TOKEN_DATA_LEN);
+    if (key == nullptr || data == nullptr) {
+        state.SkipWithError("create buffer failed");
+        DestoryBuffer(key);
+        DestoryBuffer(data);
+        return;
+    }
+    for (auto _ : state) {
+        Buffer *hmac = nullptr;
+        benchmark::DoNotOptimize(HmacSha256(key, data, &hmac));
+        DestoryBuffer(hmac);
+    }
+    DestoryBuffer(key);
+    DestoryBuffer(data);
+}
+
+void BM_HmacSha256WithContext(benchmark::State &state)
+{
+    if (!UseProvider(state)) {
+        return;
+    }
+    Buffer *key = CreateRandomBuffer(HMAC_LEN);
+    Buffer *data = CreateRandomBuffer(TOKEN_DATA_LEN);
+    HmacContext *context = (key == nullptr) ? nullptr : CreateHmacSha256Context(key);
+    if (context == nullptr || data == nullptr) {
+        state.SkipWithError("create hmac context failed");
+        DestroyHmacContext(context);
+        DestoryBuffer(key);
+        DestoryBuffer(data);
+        return;
+    }
+    uint8_t hmac[HMAC_LEN];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HmacSha256WithContext(context, data->buf, data->contentSize, hmac, HMAC_LEN));
+    }
+    DestroyHmacContext(context);
+    DestoryBuffer(key);
+    DestoryBuffer(data);
+}
+
+void BM_Ed25519Sign(benchmark::State &state)
+{
+    if (!UseProvider(state)) {
+        return;
+    }
+    KeyPair *keyPair = GenerateEd25519KeyPair();
+    Buffer *data = CreateRandomBuffer(EXECUTOR_MSG_LEN);
+    if (keyPair == nullptr || data == nullptr) {
+        state.SkipWithError("create key pair failed");
+        DestoryKeyPair(keyPair);
+        DestoryBuffer(data);
+        return;
+    }
+    uint8_t signStorage[ED25519_FIX_SIGN_BUFFER_SIZE];
+    Buffer sign = { signStorage, 0, sizeof(signStorage) };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Ed25519Sign(keyPair, data, &sign));
+    }
+    DestoryKeyPair(keyPair);
+    DestoryBuffer(data);
+}
+
+void BM_Ed25519Verify(benchmark::State &state)
+{
+    if (!UseProvider(state)) {
+        return;
+    }
+    KeyPair *keyPair = GenerateEd25519KeyPair();
+    Buffer *data = CreateRandomBuffer(EXECUTOR_MSG_LEN);
+    uint8_t signStorage[ED25519_FIX_SIGN_BUFFER_SIZE];
+    Buffer sign = { signStorage, 0, sizeof(signStorage) };
+    if (keyPair == nullptr || data == nullptr || Ed25519Sign(keyPair, data, &sign) != RESULT_SUCCESS) {
+        state.SkipWithError("sign failed");
+        DestoryKeyPair(keyPair);
+        DestoryBuffer(data);
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Ed25519Verify(keyPair->pubKey, data, &sign));
+    }
+    DestoryKeyPair(keyPair);
+    DestoryBuffer(data);
+}
+
+void BM_Ed25519VerifyWithKey(benchmark::State &state)
+{
+    if (!UseProvider(state)) {
+        return;
+    }
+    KeyPair *keyPair = GenerateEd25519KeyPair();
+    Buffer *data = CreateRandomBuffer(EXECUTOR_MSG_LEN);
+    uint8_t signStorage[ED25519_FIX_SIGN_BUFFER_SIZE];
+    Buffer sign = { signStorage, 0, sizeof(signStorage) };
+    if (keyPair == nullptr || data == nullptr || Ed25519Sign(keyPair, data, &sign) != RESULT_SUCCESS) {
+        state.SkipWithError("sign failed");
+        DestoryKeyPair(keyPair);
+        DestoryBuffer(data);
+        return;
+    }
+    Ed25519PublicKey *publicKey = CreateEd25519PublicKey(keyPair->pubKey->buf, keyPair->pubKey->contentSize);
+    if (publicKey == nullptr) {
+        state.SkipWithError("create public key failed");
+        DestoryKeyPair(keyPair);
+        DestoryBuffer(data);
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Ed25519VerifyWithKey(publicKey, data, &sign));
+    }
+    DestroyEd25519PublicKey(publicKey);
+    DestoryKeyPair(keyPair);
+    DestoryBuffer(data);
+}
+
+void BM_SecureRandom(benchmark::State &state)
+{
+    if (!UseProvider(state)) {
+        return;
+    }
+    uint64_t value = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SecureRandom(reinterpret_cast<uint8_t *>(&value), sizeof(value)));
+    }
+}
+
+void ProviderArguments(benchmark::internal::Benchmark *benchmark)
+{
+    for (CryptoProviderType type : PROVIDER_TYPES) {
+        benchmark->Arg(type);
+    }
+}
+} // namespace
+
+BENCHMARK(BM_HmacSha256)->Apply(ProviderArguments);
+BENCHMARK(BM_HmacSha256WithContext)->Apply(ProviderArguments);
+BENCHMARK(BM_Ed25519Sign)->Apply(ProviderArguments);
+BENCHMARK(BM_Ed25519Verify)->Apply(ProviderArguments);
+BENCHMARK(BM_Ed25519VerifyWithKey)->Apply(ProviderArguments);
+BENCHMARK(BM_SecureRandom)->Apply(ProviderArguments);
+} // namespace UserIAM
+} // namespace OHOS
+
+BENCHMARK_MAIN();
@@ -44,5 +44,7 @@ void UseriamUtTest015(void);
 void UseriamUtTest016(void);
 void UseriamUtTest017(void);
 void UseriamUtTest018(void);
+void UseriamUtTest019(void);
+void UseriamUtTest020(void);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "acquire_info_dispatcher.h"
+#include "coauth_info_define.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace UserIAM {
+namespace CoAuth {
+namespace {
+constexpr uint32_t REPEAT_NUM = 50;
+constexpr uint32_t SCHEDULE_NUM = 8;
+constexpr uint32_t DISPATCH_NUM = 20000;
+constexpr uint32_t ACQUIRE_KIND = 3;
+constexpr int64_t SLOW_TIP_MS = 100;
+// Longer than ACQUIRE_INFO_MIN_INTERVAL_MS plus a tick of the dispatcher thread.
+constexpr std::chrono::milliseconds SETTLE_TIME(ACQUIRE_INFO_MIN_INTERVAL_MS + 50);
+constexpr std::chrono::milliseconds IN_FLIGHT_TIME(20);
+// Far from the schedule ids of the other tests.
+constexpr uint64_t SCHEDULE_ID_BASE = 200000;
+
+// Records the tips, and counts the tips that arrive after the result.
+class FakeCoAuthCallback : public ICoAuthCallback {
+public:
+    explicit FakeCoAuthCallback(int64_t delayMs = 0) : delayMs_(delayMs) {}
+    ~FakeCoAuthCallback() override = default;
+
+    sptr<IRemoteObject> AsObject() override
+    {
+        return nullptr;
+    }
+
+    void OnFinish(uint32_t resultCode, std::vector<uint8_t> &scheduleToken) override
+    {
+        finished_ = true;
+    }
+
+    void OnAcquireInfo(uint32_t acquire) override
+    {
+        std::vector<uint8_t> extraInfo;
+        Record(acquire, extraInfo);
+    }
+
+    void OnAcquireExtraInfo(uint32_t acquire, std::vector<uint8_t> &extraInfo) override
+    {
+        Record(acquire, extraInfo);
+    }
+
+    std::vector<std::pair<uint32_t, std::size_t>> GetTips()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tips_;
+    }
+
+    std::atomic<uint32_t> lateNum_ {0};
+
+private:
+    void Record(uint32_t acquire, const std::vector<uint8_t> &extraInfo)
+    {
+        if (delayMs_ != 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delayMs_));
+        }
+        if (finished_) {
+            lateNum_++;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        tips_.emplace_back(acquire, extraInfo.size());
+    }
+
+    int64_t delayMs_;
+    std::atomic<bool> finished_ {false};
+    std::mutex mutex_;
+    std::vector<std::pair<uint32_t, std::size_t>> tips_;
+};
+
+// Ends the schedule the way the service does, before reporting its result.
+void FinishSchedule(uint64_t scheduleId, const sptr<FakeCoAuthCallback> &callback)
+{
+    AcquireInfoDispatcher::GetInstance().EndSchedule(scheduleId);
+    std::vector<uint8_t> scheduleToken;
+    callback->OnFinish(SUCCESS, scheduleToken);
+}
+} // namespace
+
+class AcquireInfoDispatcherTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void AcquireInfoDispatcherTest::SetUpTestCase(void)
+{
+}
+
+void AcquireInfoDispatcherTest::TearDownTestCase(void)
+{
+}
+
+void AcquireInfoDispatcherTest::SetUp()
+{
+}
+
+void AcquireInfoDispatcherTest::TearDown()
+{
+}
+
+/**
+ * @tc.name: AcquireInfoDispatcherTest001
+ * @tc.desc: Test that a repeated tip is sent once and that tips of unknown or ended schedules are refused.
+ * @tc.type: FUNC
+ */
+HWTEST_F(AcquireInfoDispatcherTest, AcquireInfoDispatcherTest001, TestSize.Level0)
+{
+    AcquireInfoDispatcher &dispatcher = AcquireInfoDispatcher::GetInstance();
+    std::vector<uint8_t> noExtraInfo;
+    uint64_t scheduleId = SCHEDULE_ID_BASE;
+    EXPECT_FALSE(dispatcher.Dispatch(scheduleId, 1, noExtraInfo));
+
+    sptr<FakeCoAuthCallback> callback = new FakeCoAuthCallback();
+    dispatcher.Begin(scheduleId, callback);
+    for (uint32_t i = 0; i < REPEAT_NUM; i++) {
+        EXPECT_TRUE(dispatcher.Dispatch(scheduleId, 1, noExtraInfo));
+    }
+    std::this_thread::sleep_for(SETTLE_TIME);
+    EXPECT_EQ(callback->GetTips().size(), 1u);
+
+    FinishSchedule(scheduleId, callback);
+    EXPECT_FALSE(dispatcher.Dispatch(scheduleId, 2, noExtraInfo));
+    EXPECT_EQ(callback->GetTips().size(), 1u);
+}
+
+/**
+ * @tc.name: AcquireInfoDispatcherTest002
+ * @tc.desc: Test that only the latest tip of an interval is sent when it ends, and never one equal to the last.
+ * @tc.type: FUNC
+ */
+HWTEST_F(AcquireInfoDispatcherTest, AcquireInfoDispatcherTest002, TestSize.Level1)
+{
+    AcquireInfoDispatcher &dispatcher = AcquireInfoDispatcher::GetInstance();
+    std::vector<uint8_t> noExtraInfo;
+    std::vector<uint8_t> extraInfo = { 1, 2, 3 };
+    uint64_t scheduleId = SCHEDULE_ID_BASE + 1;
+    sptr<FakeCoAuthCallback> callback = new FakeCoAuthCallback();
+    dispatcher.Begin(scheduleId, callback);
+    EXPECT_TRUE(dispatcher.Dispatch(scheduleId, 7, noExtraInfo));
+    EXPECT_TRUE(dispatcher.Dispatch(scheduleId, 8, noExtraInfo));
+    EXPECT_TRUE(dispatcher.Dispatch(scheduleId, 9, extraInfo));
+    EXPECT_EQ(callback->GetTips().size(), 1u);
+    std::this_thread::sleep_for(SETTLE_TIME);
+    auto tips = callback->GetTips();
+    ASSERT_EQ(tips.size(), 2u);
+    EXPECT_EQ(tips[0], std::make_pair(7u, std::size_t(0)));
+    EXPECT_EQ(tips[1], std::make_pair(9u, extraInfo.size()));
+
+    // The held back tip went back to the last one sent, nothing new to say.
+    EXPECT_TRUE(dispatcher.Dispatch(scheduleId, 10, noExtraInfo));
+    EXPECT_TRUE(dispatcher.Dispatch(scheduleId, 9, extraInfo));
+    std::this_thread::sleep_for(SETTLE_TIME);
+    EXPECT_EQ(callback->GetTips().size(), 2u);
+    FinishSchedule(scheduleId, callback);
+}
+
+/**
+ * @tc.name: AcquireInfoDispatcherTest003
+ * @tc.desc: Test that ending a schedule drops its held back tip and waits for a tip being sent.
+ * @tc.type: FUNC
+ */
+HWTEST_F(AcquireInfoDispatcherTest, AcquireInfoDispatcherTest003, TestSize.Level1)
+{
+    AcquireInfoDispatcher &dispatcher = AcquireInfoDispatcher::GetInstance();
+    std::vector<uint8_t> noExtraInfo;
+    uint64_t scheduleId = SCHEDULE_ID_BASE + 2;
+    sptr<FakeCoAuthCallback> callback = new FakeCoAuthCallback();
+    dispatcher.Begin(scheduleId, callback);
+    EXPECT_TRUE(dispatcher.Dispatch(scheduleId, 1, noExtraInfo));
+    EXPECT_TRUE(dispatcher.Dispatch(scheduleId, 2, noExtraInfo));
+    FinishSchedule(scheduleId, callback);
+    std::this_thread::sleep_for(SETTLE_TIME);
+    EXPECT_EQ(callback->GetTips().size(), 1u);
+    EXPECT_EQ(callback->lateNum_.load(), 0u);
+
+    scheduleId++;
+    sptr<FakeCoAuthCallback> slowCallback = new FakeCoAuthCallback(SLOW_TIP_MS);
+    dispatcher.Begin(scheduleId, slowCallback);
+    std::thread sender([&dispatcher, &noExtraInfo, scheduleId] {
+        (void)dispatcher.Dispatch(scheduleId, 1, noExtraInfo);
+    });
+    std::this_thread::sleep_for(IN_FLIGHT_TIME);
+    FinishSchedule(scheduleId, slowCallback);
+    sender.join();
+    EXPECT_EQ(slowCallback->GetTips().size(), 1u);
+    EXPECT_EQ(slowCallback->lateNum_.load(), 0u);
+}
+
+/**
+ * @tc.name: AcquireInfoDispatcherTest004
+ * @tc.desc: Test that no tip reaches a callback after its result while many schedules send and end at once.
+ * @tc.type: FUNC
+ */
+HWTEST_F(AcquireInfoDispatcherTest, AcquireInfoDispatcherTest004, TestSize.Level1)
+{
+    AcquireInfoDispatcher &dispatcher = AcquireInfoDispatcher::GetInstance();
+    std::vector<sptr<FakeCoAuthCallback>> callbacks;
+    for (uint32_t i = 0; i < SCHEDULE_NUM; i++) {
+        callbacks.push_back(new FakeCoAuthCallback());
+        dispatcher.Begin(SCHEDULE_ID_BASE + 10 + i, callbacks[i]);
+    }
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < SCHEDULE_NUM; i++) {
+        uint64_t scheduleId = SCHEDULE_ID_BASE + 10 + i;
+        threads.emplace_back([&dispatcher, scheduleId] {
+            std::vector<uint8_t> noExtraInfo;
+            for (uint32_t j = 0; j < DISPATCH_NUM; j++) {
+                (void)dispatcher.Dispatch(scheduleId, j % ACQUIRE_KIND, noExtraInfo);
+            }
+        });
+        threads.emplace_back([&callbacks, scheduleId, i] {
+            std::this_thread::sleep_for(IN_FLIGHT_TIME * (i + 1));
+            FinishSchedule(scheduleId, callbacks[i]);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::this_thread::sleep_for(SETTLE_TIME);
+    for (auto &callback : callbacks) {
+        EXPECT_EQ(callback->lateNum_.load(), 0u);
+    }
+}
+} // namespace CoAuth
+} // namespace UserIAM
+} // namespace OHOS
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <functional>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "adaptor_memory.h"
+}
+
+using namespace testing::ext;
+namespace OHOS {
+namespace UserIAM {
+namespace {
+constexpr size_t SMALL_BLOCK_SIZE = 40;
+constexpr size_t LARGE_BLOCK_SIZE = 4096;
+constexpr uint32_t POOLED_BLOCK_NUM = 32;
+constexpr uint8_t FILL_BYTE = 0x5a;
+// Larger than the scratch arena of a thread.
+constexpr size_t OVERSIZED_ARENA_BLOCK_SIZE = 32768;
+constexpr uint32_t ARENA_THREAD_NUM = 4;
+constexpr uint32_t ARENA_ROUND_NUM = 1000;
+
+bool IsWiped(const uint8_t *block, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        if (block[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Odd rounds allocate from the arena of the thread, even rounds from the pool.
+void UseArena(bool &passed)
+{
+    passed = true;
+    for (uint32_t i = 0; i < ARENA_ROUND_NUM; i++) {
+        bool inArena = (i % 2 != 0);
+        if (inArena) {
+            BeginMemoryArena();
+        }
+        uint8_t *block = static_cast<uint8_t *>(ArenaMalloc(SMALL_BLOCK_SIZE));
+        if (block == nullptr) {
+            passed = false;
+            return;
+        }
+        (void)memset(block, FILL_BYTE, SMALL_BLOCK_SIZE);
+        for (size_t k = 0; k < SMALL_BLOCK_SIZE; k++) {
+            passed = passed && (block[k] == FILL_BYTE);
+        }
+        PoolFree(block, SMALL_BLOCK_SIZE);
+        if (inArena) {
+            EndMemoryArena();
+        }
+    }
+}
+} // namespace
+
+class AdaptorMemoryTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void AdaptorMemoryTest::SetUpTestCase(void)
+{
+}
+
+void AdaptorMemoryTest::TearDownTestCase(void)
+{
+}
+
+void AdaptorMemoryTest::SetUp()
+{
+}
+
+void AdaptorMemoryTest::TearDown()
+{
+    DestroyMemoryPool();
+}
+
+/**
+ * @tc.name: AdaptorMemoryTest001
+ * @tc.desc: Test that a released small block is wiped and handed out again for the same size class.
+ * @tc.type: FUNC
+ */
+HWTEST_F(AdaptorMemoryTest, AdaptorMemoryTest001, TestSize.Level0)
+{
+    uint8_t *block = static_cast<uint8_t *>(PoolMalloc(SMALL_BLOCK_SIZE));
+    ASSERT_NE(block, nullptr);
+    (void)memset(block, FILL_BYTE, SMALL_BLOCK_SIZE);
+    PoolFree(block, SMALL_BLOCK_SIZE);
+
+    uint8_t *reused = static_cast<uint8_t *>(PoolMalloc(SMALL_BLOCK_SIZE + 1));
+    EXPECT_EQ(reused, block);
+    EXPECT_TRUE(IsWiped(reused, SMALL_BLOCK_SIZE));
+    PoolFree(reused, SMALL_BLOCK_SIZE + 1);
+}
+
+/**
+ * @tc.name: AdaptorMemoryTest002
+ * @tc.desc: Test that blocks beyond the size classes and the pool capacity are released to the heap.
+ * @tc.type: FUNC
+ */
+HWTEST_F(AdaptorMemoryTest, AdaptorMemoryTest002, TestSize.Level0)
+{
+    EXPECT_EQ(PoolMalloc(0), nullptr);
+    uint8_t *large = static_cast<uint8_t *>(PoolMalloc(LARGE_BLOCK_SIZE));
+    ASSERT_NE(large, nullptr);
+    (void)memset(large, FILL_BYTE, LARGE_BLOCK_SIZE);
+    PoolFree(large, LARGE_BLOCK_SIZE);
+
+    void *blocks[POOLED_BLOCK_NUM] = { nullptr };
+    for (uint32_t i = 0; i < POOLED_BLOCK_NUM; i++) {
+        blocks[i] = PoolMalloc(SMALL_BLOCK_SIZE);
+        ASSERT_NE(blocks[i], nullptr);
+    }
+    for (uint32_t i = 0; i < POOLED_BLOCK_NUM; i++) {
+        PoolFree(blocks[i], SMALL_BLOCK_SIZE);
+    }
+    PoolFree(nullptr, SMALL_BLOCK_SIZE);
+}
+
+/**
+ * @tc.name: AdaptorMemoryTest003
+ * @tc.desc: Test that arena memory is wiped on Free and when the outermost arena ends, and reused only then.
+ * @tc.type: FUNC
+ */
+HWTEST_F(AdaptorMemoryTest, AdaptorMemoryTest003, TestSize.Level0)
+{
+    BeginMemoryArena();
+    uint8_t *first = static_cast<uint8_t *>(ArenaMalloc(SMALL_BLOCK_SIZE));
+    ASSERT_NE(first, nullptr);
+    (void)memset(first, FILL_BYTE, SMALL_BLOCK_SIZE);
+    Free(first);
+    EXPECT_TRUE(IsWiped(first, SMALL_BLOCK_SIZE));
+    uint8_t *kept = static_cast<uint8_t *>(ArenaMalloc(SMALL_BLOCK_SIZE));
+    ASSERT_NE(kept, nullptr);
+    (void)memset(kept, FILL_BYTE, SMALL_BLOCK_SIZE);
+    BeginMemoryArena();
+    uint8_t *second = static_cast<uint8_t *>(ArenaMalloc(SMALL_BLOCK_SIZE));
+    EXPECT_NE(second, first);
+    EXPECT_NE(second, kept);
+    EndMemoryArena();
+    EXPECT_EQ(kept[0], FILL_BYTE);
+    EndMemoryArena();
+    EXPECT_TRUE(IsWiped(kept, SMALL_BLOCK_SIZE));
+
+    BeginMemoryArena();
+    EXPECT_EQ(ArenaMalloc(SMALL_BLOCK_SIZE), first);
+    EndMemoryArena();
+}
+
+/**
+ * @tc.name: AdaptorMemoryTest004
+ * @tc.desc: Test that ArenaMalloc falls back to the pool without an open arena and for blocks the arena can't hold.
+ * @tc.type: FUNC
+ */
+HWTEST_F(AdaptorMemoryTest, AdaptorMemoryTest004, TestSize.Level0)
+{
+    uint8_t *pooled = static_cast<uint8_t *>(ArenaMalloc(SMALL_BLOCK_SIZE));
+    ASSERT_NE(pooled, nullptr);
+    PoolFree(pooled, SMALL_BLOCK_SIZE);
+    EXPECT_EQ(PoolMalloc(SMALL_BLOCK_SIZE), pooled);
+    PoolFree(pooled, SMALL_BLOCK_SIZE);
+
+    BeginMemoryArena();
+    uint8_t *oversized = static_cast<uint8_t *>(ArenaMalloc(OVERSIZED_ARENA_BLOCK_SIZE));
+    ASSERT_NE(oversized, nullptr);
+    (void)memset(oversized, FILL_BYTE, OVERSIZED_ARENA_BLOCK_SIZE);
+    Free(oversized);
+    EndMemoryArena();
+}
+
+/**
+ * @tc.name: AdaptorMemoryTest005
+ * @tc.desc: Test that threads using their arenas and the pool at the same time never share a block.
+ * @tc.type: FUNC
+ */
+HWTEST_F(AdaptorMemoryTest, AdaptorMemoryTest005, TestSize.Level0)
+{
+    bool passed[ARENA_THREAD_NUM] = { false };
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < ARENA_THREAD_NUM; i++) {
+        threads.emplace_back(UseArena, std::ref(passed[i]));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (uint32_t i = 0; i < ARENA_THREAD_NUM; i++) {
+        EXPECT_TRUE(passed[i]);
+    }
+}
+} // namespace UserIAM
+} // namespace OHOS
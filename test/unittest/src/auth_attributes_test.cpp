@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "auth_attributes.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace UserIAM {
+namespace AuthResPool {
+namespace {
+constexpr uint32_t PIN_AUTH_TYPE = 1;
+constexpr uint32_t FACE_AUTH_TYPE = 2;
+constexpr uint64_t TEMPLATE_ID = 9;
+
+void PutUint32(std::vector<uint8_t> &buffer, uint32_t value)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+void PutTlv(std::vector<uint8_t> &buffer, uint32_t type, const std::vector<uint8_t> &value)
+{
+    PutUint32(buffer, type);
+    PutUint32(buffer, value.size());
+    buffer.insert(buffer.end(), value.begin(), value.end());
+}
+} // namespace
+
+class AuthAttributesTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void AuthAttributesTest::SetUpTestCase(void)
+{
+}
+
+void AuthAttributesTest::TearDownTestCase(void)
+{
+}
+
+void AuthAttributesTest::SetUp()
+{
+}
+
+void AuthAttributesTest::TearDown()
+{
+}
+
+/**
+ * @tc.name: AuthAttributesTest001
+ * @tc.desc: Test that Pack returns the same bytes until a value changes, and the new value afterwards.
+ * @tc.type: FUNC
+ */
+HWTEST_F(AuthAttributesTest, AuthAttributesTest001, TestSize.Level0)
+{
+    AuthAttributes attributes;
+    attributes.SetUint32Value(AUTH_TYPE, PIN_AUTH_TYPE);
+    attributes.SetUint64Value(AUTH_TEMPLATE_ID, TEMPLATE_ID);
+    std::vector<uint8_t> first;
+    EXPECT_EQ(attributes.Pack(first), SUCCESS);
+    std::vector<uint8_t> second;
+    EXPECT_EQ(attributes.Pack(second), SUCCESS);
+    EXPECT_EQ(first, second);
+
+    attributes.SetUint32Value(AUTH_TYPE, FACE_AUTH_TYPE);
+    std::vector<uint8_t> changed;
+    EXPECT_EQ(attributes.Pack(changed), SUCCESS);
+    EXPECT_NE(changed, first);
+    AuthAttributes received;
+    ASSERT_NE(received.Unpack(changed), nullptr);
+    uint32_t authType = 0;
+    received.GetUint32Value(AUTH_TYPE, authType);
+    EXPECT_EQ(authType, FACE_AUTH_TYPE);
+    uint64_t templateId = 0;
+    received.GetUint64Value(AUTH_TEMPLATE_ID, templateId);
+    EXPECT_EQ(templateId, TEMPLATE_ID);
+
+    AuthAttributes copy(attributes);
+    std::vector<uint8_t> copied;
+    EXPECT_EQ(copy.Pack(copied), SUCCESS);
+    EXPECT_EQ(copied, changed);
+}
+
+/**
+ * @tc.name: AuthAttributesTest002
+ * @tc.desc: Test that received bytes are never sent again as they came, Pack sends the normalized encoding.
+ * @tc.type: FUNC
+ */
+HWTEST_F(AuthAttributesTest, AuthAttributesTest002, TestSize.Level0)
+{
+    // AUTH_ROOT { AUTH_DATA { AUTH_TYPE = 1, AUTH_TYPE = 2 }, AUTH_SIGNATURE {} }, the later value wins.
+    std::vector<uint8_t> pinType;
+    PutUint32(pinType, PIN_AUTH_TYPE);
+    std::vector<uint8_t> faceType;
+    PutUint32(faceType, FACE_AUTH_TYPE);
+    std::vector<uint8_t> data;
+    PutTlv(data, AUTH_TYPE, pinType);
+    PutTlv(data, AUTH_TYPE, faceType);
+    std::vector<uint8_t> root;
+    PutTlv(root, AUTH_DATA, data);
+    PutTlv(root, AUTH_SIGNATURE, {});
+    std::vector<uint8_t> wire;
+    PutTlv(wire, AUTH_ROOT, root);
+
+    AuthAttributes received;
+    ASSERT_NE(received.Unpack(wire), nullptr);
+    std::vector<uint8_t> packed;
+    EXPECT_EQ(received.Pack(packed), SUCCESS);
+    EXPECT_NE(packed, wire);
+    AuthAttributes check;
+    ASSERT_NE(check.Unpack(packed), nullptr);
+    uint32_t authType = 0;
+    check.GetUint32Value(AUTH_TYPE, authType);
+    EXPECT_EQ(authType, FACE_AUTH_TYPE);
+    std::vector<uint8_t> again;
+    EXPECT_EQ(received.Pack(again), SUCCESS);
+    EXPECT_EQ(again, packed);
+}
+} // namespace AuthResPool
+} // namespace UserIAM
+} // namespace OHOS
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "call_monitor.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace UserIAM {
+namespace CoAuth {
+namespace {
+constexpr uint32_t CALL_NUM = 200;
+constexpr uint32_t WAIT_TIME_KIND = 5;
+constexpr int64_t SHORTEST_WAIT_TIME_MS = 150;
+constexpr int64_t WAIT_TIME_STEP_MS = 100;
+// A timeout runs on the first tick after it is due, the tolerance covers the tick and a loaded machine.
+constexpr int64_t FIRE_TOLERANCE_MS = 250;
+constexpr int64_t LONG_WAIT_TIME_MS = 60000;
+// More than one revolution of the wheel.
+constexpr int64_t MULTI_ROUND_WAIT_TIME_MS = 51300;
+constexpr std::chrono::milliseconds SETTLE_TIME(900);
+constexpr std::chrono::milliseconds SHORT_SETTLE_TIME(300);
+// Far from the schedule ids of the other tests.
+constexpr uint64_t SCHEDULE_ID_BASE = 100000;
+
+using Clock = std::chrono::steady_clock;
+} // namespace
+
+class CallMonitorTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void CallMonitorTest::SetUpTestCase(void)
+{
+}
+
+void CallMonitorTest::TearDownTestCase(void)
+{
+}
+
+void CallMonitorTest::SetUp()
+{
+}
+
+void CallMonitorTest::TearDown()
+{
+}
+
+/**
+ * @tc.name: CallMonitorTest001
+ * @tc.desc: Test that every monitored call times out once and on time, and that removed calls never do.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CallMonitorTest, CallMonitorTest001, TestSize.Level1)
+{
+    CallMonitor &monitor = CallMonitor::GetInstance();
+    std::vector<std::atomic<int64_t>> firedAt(CALL_NUM);
+    std::vector<std::atomic<uint32_t>> fireNum(CALL_NUM);
+    for (uint32_t i = 0; i < CALL_NUM; i++) {
+        firedAt[i] = -1;
+        fireNum[i] = 0;
+    }
+    Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < CALL_NUM; i++) {
+        Callback timeoutFun = [&firedAt, &fireNum, start, i] {
+            firedAt[i] = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+            fireNum[i]++;
+        };
+        monitor.MonitorCall(SHORTEST_WAIT_TIME_MS + (i % WAIT_TIME_KIND) * WAIT_TIME_STEP_MS, SCHEDULE_ID_BASE + i,
+            timeoutFun);
+    }
+    for (uint32_t i = 0; i < CALL_NUM; i += 2) {
+        monitor.MonitorRemoveCall(SCHEDULE_ID_BASE + i);
+    }
+    std::this_thread::sleep_for(SETTLE_TIME);
+
+    for (uint32_t i = 0; i < CALL_NUM; i++) {
+        if (i % 2 == 0) {
+            EXPECT_EQ(fireNum[i].load(), 0u);
+            continue;
+        }
+        int64_t waitTime = SHORTEST_WAIT_TIME_MS + (i % WAIT_TIME_KIND) * WAIT_TIME_STEP_MS;
+        EXPECT_EQ(fireNum[i].load(), 1u);
+        EXPECT_GE(firedAt[i].load(), waitTime);
+        EXPECT_LT(firedAt[i].load(), waitTime + FIRE_TOLERANCE_MS);
+    }
+}
+
+/**
+ * @tc.name: CallMonitorTest002
+ * @tc.desc: Test that monitoring a call again replaces its timeout and that long timeouts don't fire early.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CallMonitorTest, CallMonitorTest002, TestSize.Level1)
+{
+    CallMonitor &monitor = CallMonitor::GetInstance();
+    std::atomic<uint32_t> shortFired(0);
+    std::atomic<uint32_t> longFired(0);
+    Callback shortTimeout = [&shortFired] { shortFired++; };
+    Callback longTimeout = [&longFired] { longFired++; };
+    monitor.MonitorCall(SHORTEST_WAIT_TIME_MS, SCHEDULE_ID_BASE, shortTimeout);
+    monitor.MonitorCall(LONG_WAIT_TIME_MS, SCHEDULE_ID_BASE, longTimeout);
+    monitor.MonitorCall(MULTI_ROUND_WAIT_TIME_MS, SCHEDULE_ID_BASE + 1, longTimeout);
+    std::this_thread::sleep_for(SHORT_SETTLE_TIME);
+    EXPECT_EQ(shortFired.load(), 0u);
+    EXPECT_EQ(longFired.load(), 0u);
+    monitor.MonitorRemoveCall(SCHEDULE_ID_BASE);
+    monitor.MonitorRemoveCall(SCHEDULE_ID_BASE + 1);
+    monitor.MonitorRemoveCall(SCHEDULE_ID_BASE + 1);
+}
+} // namespace CoAuth
+} // namespace UserIAM
+} // namespace OHOS
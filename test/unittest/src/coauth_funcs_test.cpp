@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+extern "C" {
+#include "adaptor_algorithm.h"
+#include "adaptor_memory.h"
+#include "adaptor_time.h"
+#include "coauth.h"
+#include "coauth_sign_centre.h"
+#include "coauth_funcs.h"
+#include "executor_message.h"
+#include "pool.h"
+#include "token_key.h"
+}
+
+using namespace testing::ext;
+namespace OHOS {
+namespace UserIAM {
+namespace {
+constexpr uint64_t TEMPLATE_ID = 7;
+constexpr uint64_t CHALLENGE = 1;
+constexpr uint32_t FINISH_ROUND_NUM = 20;
+
+void PutTlv(std::vector<uint8_t> &msg, int32_t type, const void *value, uint32_t length)
+{
+    const uint8_t *typeBytes = reinterpret_cast<const uint8_t *>(&type);
+    const uint8_t *lengthBytes = reinterpret_cast<const uint8_t *>(&length);
+    const uint8_t *valueBytes = static_cast<const uint8_t *>(value);
+    msg.insert(msg.end(), typeBytes, typeBytes + sizeof(type));
+    msg.insert(msg.end(), lengthBytes, lengthBytes + sizeof(length));
+    msg.insert(msg.end(), valueBytes, valueBytes + length);
+}
+
+// The signed result an all in one executor sends when the schedule succeeds.
+std::vector<uint8_t> CreateFinishMsg(const KeyPair *keyPair, uint64_t scheduleId)
+{
+    std::vector<uint8_t> data;
+    uint32_t capabilityLevel = 1;
+    uint64_t templateId = TEMPLATE_ID;
+    uint64_t authSubType = 0;
+    int32_t resultCode = RESULT_SUCCESS;
+    PutTlv(data, AUTH_CAPABILITY_LEVEL, &capabilityLevel, sizeof(capabilityLevel));
+    PutTlv(data, AUTH_TEMPLATE_ID, &templateId, sizeof(templateId));
+    PutTlv(data, AUTH_SUBTYPE, &authSubType, sizeof(authSubType));
+    PutTlv(data, AUTH_RESULT_CODE, &resultCode, sizeof(resultCode));
+    PutTlv(data, AUTH_SCHEDULE_ID, &scheduleId, sizeof(scheduleId));
+
+    std::vector<uint8_t> msg;
+    Buffer *dataBuffer = CreateBufferByData(data.data(), data.size());
+    std::vector<uint8_t> signStorage(ED25519_FIX_SIGN_BUFFER_SIZE);
+    Buffer sign = { signStorage.data(), 0, ED25519_FIX_SIGN_BUFFER_SIZE };
+    if (dataBuffer == nullptr || Ed25519Sign(keyPair, dataBuffer, &sign) != RESULT_SUCCESS) {
+        DestoryBuffer(dataBuffer);
+        return msg;
+    }
+    std::vector<uint8_t> root;
+    PutTlv(root, AUTH_DATA, data.data(), data.size());
+    PutTlv(root, AUTH_SIGNATURE, sign.buf, sign.contentSize);
+    PutTlv(msg, AUTH_ROOT, root.data(), root.size());
+    DestoryBuffer(dataBuffer);
+    return msg;
+}
+} // namespace
+
+class CoAuthFuncsTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+
+protected:
+    static KeyPair *keyPair_;
+};
+
+KeyPair *CoAuthFuncsTest::keyPair_ = nullptr;
+
+void CoAuthFuncsTest::SetUpTestCase(void)
+{
+    ASSERT_EQ(InitResourcePool(), RESULT_SUCCESS);
+    ASSERT_EQ(InitCoAuth(), RESULT_SUCCESS);
+    ASSERT_EQ(InitTokenKey(), RESULT_SUCCESS);
+    keyPair_ = GenerateEd25519KeyPair();
+    ASSERT_NE(keyPair_, nullptr);
+    ExecutorInfoHal executorInfo = {};
+    executorInfo.authType = PIN_AUTH;
+    executorInfo.executorType = ALL_IN_ONE;
+    (void)memcpy(executorInfo.pubKey, keyPair_->pubKey->buf, PUBLIC_KEY_LEN);
+    ASSERT_EQ(RegisterExecutorToPool(&executorInfo), RESULT_SUCCESS);
+}
+
+void CoAuthFuncsTest::TearDownTestCase(void)
+{
+    DestoryKeyPair(keyPair_);
+    keyPair_ = nullptr;
+    DestoryCoAuth();
+    DestroyResourcePool();
+    DestroyMemoryPool();
+}
+
+void CoAuthFuncsTest::SetUp()
+{
+}
+
+void CoAuthFuncsTest::TearDown()
+{
+}
+
+/**
+ * @tc.name: CoAuthFuncsTest001
+ * @tc.desc: Test that a schedule finishes and is removed the same way with the message in an arena and on the heap.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CoAuthFuncsTest, CoAuthFuncsTest001, TestSize.Level0)
+{
+    for (uint32_t round = 0; round < FINISH_ROUND_NUM; round++) {
+        bool inArena = (round % 2 == 0);
+        CoAuthSchedule *schedule = GenerateIdmSchedule(CHALLENGE, PIN_AUTH, 0);
+        ASSERT_NE(schedule, nullptr);
+        uint64_t scheduleId = schedule->scheduleId;
+        ASSERT_EQ(AddCoAuthSchedule(schedule), RESULT_SUCCESS);
+        DestroyCoAuthSchedule(schedule);
+        std::vector<uint8_t> msg = CreateFinishMsg(keyPair_, scheduleId);
+        ASSERT_FALSE(msg.empty());
+
+        if (inArena) {
+            BeginMemoryArena();
+        }
+        Buffer *msgBuffer = inArena ? CreateArenaBufferByData(msg.data(), msg.size()) :
+            CreateBufferByData(msg.data(), msg.size());
+        ASSERT_NE(msgBuffer, nullptr);
+        ScheduleTokenHal scheduleToken = {};
+        scheduleToken.scheduleId = scheduleId;
+        EXPECT_EQ(ScheduleFinish(msgBuffer, &scheduleToken), RESULT_SUCCESS);
+        DestoryBuffer(msgBuffer);
+        if (inArena) {
+            EndMemoryArena();
+        }
+        EXPECT_EQ(scheduleToken.templateId, TEMPLATE_ID);
+        EXPECT_NE(RemoveCoAuthSchedule(scheduleId), RESULT_SUCCESS);
+    }
+}
+
+/**
+ * @tc.name: CoAuthFuncsTest002
+ * @tc.desc: Test that a message with a broken signature is refused inside an arena and still ends the schedule.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CoAuthFuncsTest, CoAuthFuncsTest002, TestSize.Level0)
+{
+    CoAuthSchedule *schedule = GenerateIdmSchedule(CHALLENGE, PIN_AUTH, 0);
+    ASSERT_NE(schedule, nullptr);
+    uint64_t scheduleId = schedule->scheduleId;
+    ASSERT_EQ(AddCoAuthSchedule(schedule), RESULT_SUCCESS);
+    DestroyCoAuthSchedule(schedule);
+    std::vector<uint8_t> msg = CreateFinishMsg(keyPair_, scheduleId);
+    ASSERT_FALSE(msg.empty());
+    // The signature is the last value of the message.
+    msg.back() ^= 1;
+
+    BeginMemoryArena();
+    Buffer *msgBuffer = CreateArenaBufferByData(msg.data(), msg.size());
+    ASSERT_NE(msgBuffer, nullptr);
+    ScheduleTokenHal scheduleToken = {};
+    scheduleToken.scheduleId = scheduleId;
+    EXPECT_NE(ScheduleFinish(msgBuffer, &scheduleToken), RESULT_SUCCESS);
+    DestoryBuffer(msgBuffer);
+    EndMemoryArena();
+    EXPECT_NE(RemoveCoAuthSchedule(scheduleId), RESULT_SUCCESS);
+}
+
+/**
+ * @tc.name: CoAuthFuncsTest003
+ * @tc.desc: Test that a schedule still finishes when its executor is unregistered before the result arrives.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CoAuthFuncsTest, CoAuthFuncsTest003, TestSize.Level0)
+{
+    CoAuthSchedule *schedule = GenerateIdmSchedule(CHALLENGE, PIN_AUTH, 0);
+    ASSERT_NE(schedule, nullptr);
+    uint64_t scheduleId = schedule->scheduleId;
+    uint64_t executorId = schedule->executors[0].executorId;
+    ASSERT_EQ(AddCoAuthSchedule(schedule), RESULT_SUCCESS);
+    DestroyCoAuthSchedule(schedule);
+    ASSERT_EQ(UnregisterExecutorToPool(executorId), RESULT_SUCCESS);
+
+    std::vector<uint8_t> msg = CreateFinishMsg(keyPair_, scheduleId);
+    ASSERT_FALSE(msg.empty());
+    Buffer *msgBuffer = CreateBufferByData(msg.data(), msg.size());
+    ASSERT_NE(msgBuffer, nullptr);
+    ScheduleTokenHal scheduleToken = {};
+    scheduleToken.scheduleId = scheduleId;
+    EXPECT_EQ(ScheduleFinish(msgBuffer, &scheduleToken), RESULT_SUCCESS);
+    DestoryBuffer(msgBuffer);
+    EXPECT_EQ(scheduleToken.templateId, TEMPLATE_ID);
+
+    ExecutorInfoHal executorInfo = {};
+    executorInfo.authType = PIN_AUTH;
+    executorInfo.executorType = ALL_IN_ONE;
+    (void)memcpy(executorInfo.pubKey, keyPair_->pubKey->buf, PUBLIC_KEY_LEN);
+    ASSERT_EQ(RegisterExecutorToPool(&executorInfo), RESULT_SUCCESS);
+}
+
+/**
+ * @tc.name: CoAuthFuncsTest004
+ * @tc.desc: Test that a batch of schedule tokens gets the result of each token and fails on the first bad one.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CoAuthFuncsTest, CoAuthFuncsTest004, TestSize.Level0)
+{
+    ScheduleTokenHal scheduleTokens[FINISH_ROUND_NUM] = {};
+    ResultCode results[FINISH_ROUND_NUM] = {};
+    for (uint32_t i = 0; i < FINISH_ROUND_NUM; i++) {
+        scheduleTokens[i].scheduleId = i;
+        scheduleTokens[i].time = GetSystemTime();
+        ASSERT_EQ(CoAuthTokenSign(&scheduleTokens[i]), RESULT_SUCCESS);
+    }
+    EXPECT_EQ(CoAuthTokenVerifyBatch(scheduleTokens, FINISH_ROUND_NUM, results), RESULT_SUCCESS);
+
+    scheduleTokens[1].templateId = TEMPLATE_ID;
+    EXPECT_EQ(CoAuthTokenVerifyBatch(scheduleTokens, FINISH_ROUND_NUM, results), RESULT_BAD_SIGN);
+    EXPECT_EQ(results[0], RESULT_SUCCESS);
+    EXPECT_EQ(results[1], RESULT_BAD_SIGN);
+    EXPECT_EQ(results[FINISH_ROUND_NUM - 1], RESULT_SUCCESS);
+    EXPECT_EQ(CoAuthTokenVerifyBatch(scheduleTokens, MAX_VERIFY_TOKEN_NUM + 1, results), RESULT_BAD_PARAM);
+}
+} // namespace UserIAM
+} // namespace OHOS
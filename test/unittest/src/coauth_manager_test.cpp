@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "coauth_manager.h"
+#include "executor_prop_cache.h"
+#include "useriam_common.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace UserIAM {
+namespace CoAuth {
+namespace {
+constexpr uint32_t PIN_AUTH_TYPE = PIN;
+constexpr uint32_t FACE_AUTH_TYPE = FACE;
+constexpr uint32_t PUBLIC_KEY_SIZE = 32;
+
+class FakeRemoteObject : public IRemoteObject {
+public:
+    FakeRemoteObject() : IRemoteObject(u"fake_executor_callback") {}
+    ~FakeRemoteObject() override = default;
+
+    int32_t GetObjectRefCount() override
+    {
+        return 0;
+    }
+
+    int SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override
+    {
+        return 0;
+    }
+
+    bool AddDeathRecipient(const sptr<DeathRecipient> &recipient) override
+    {
+        return true;
+    }
+
+    bool RemoveDeathRecipient(const sptr<DeathRecipient> &recipient) override
+    {
+        return true;
+    }
+
+    int Dump(int fd, const std::vector<std::u16string> &args) override
+    {
+        return 0;
+    }
+};
+
+// Answers each condition with its templateId as the remaining count, so the tests can tell which value belongs to
+// which condition. The batched calls return batchRet_, an executor predating them returns BATCH_NOT_SUPPORT.
+class FakeExecutorCallback : public ResIExecutorCallback {
+public:
+    explicit FakeExecutorCallback(int32_t batchRet) : batchRet_(batchRet), remote_(new FakeRemoteObject()) {}
+    ~FakeExecutorCallback() override = default;
+
+    sptr<IRemoteObject> AsObject() override
+    {
+        return remote_;
+    }
+
+    void OnMessengerReady(const sptr<UserIAM::AuthResPool::IExecutorMessenger> &messenger) override
+    {
+    }
+
+    int32_t OnBeginExecute(uint64_t scheduleId, std::vector<uint8_t> &publicKey,
+        std::shared_ptr<ResAuthAttributes> commandAttrs) override
+    {
+        return FAIL;
+    }
+
+    int32_t OnEndExecute(uint64_t scheduleId, std::shared_ptr<ResAuthAttributes> consumerAttr) override
+    {
+        return FAIL;
+    }
+
+    void OnCancelExecute(uint64_t scheduleId, std::shared_ptr<ResAuthAttributes> consumerAttr) override
+    {
+    }
+
+    int32_t OnSetProperty(std::shared_ptr<ResAuthAttributes> properties) override
+    {
+        singleNum_++;
+        return SUCCESS;
+    }
+
+    int32_t OnGetProperty(std::shared_ptr<ResAuthAttributes> conditions,
+        std::shared_ptr<ResAuthAttributes> values) override
+    {
+        singleNum_++;
+        uint64_t templateId = 0;
+        conditions->GetUint64Value(AUTH_TEMPLATE_ID, templateId);
+        values->SetUint32Value(AUTH_REMAIN_COUNT, static_cast<uint32_t>(templateId));
+        return SUCCESS;
+    }
+
+    int32_t OnGetProperties(std::vector<std::shared_ptr<ResAuthAttributes>> &conditions,
+        std::vector<std::shared_ptr<ResAuthAttributes>> &values, std::vector<int32_t> &results) override
+    {
+        batchNum_++;
+        if (batchRet_ != SUCCESS) {
+            return batchRet_;
+        }
+        for (auto &condition : conditions) {
+            uint64_t templateId = 0;
+            condition->GetUint64Value(AUTH_TEMPLATE_ID, templateId);
+            batchTemplateIds_.push_back(templateId);
+            auto value = std::make_shared<ResAuthAttributes>();
+            value->SetUint32Value(AUTH_REMAIN_COUNT, static_cast<uint32_t>(templateId));
+            values.push_back(value);
+            results.push_back(SUCCESS);
+        }
+        return SUCCESS;
+    }
+
+    int32_t OnSetProperties(std::vector<std::shared_ptr<ResAuthAttributes>> &properties,
+        std::vector<int32_t> &results) override
+    {
+        batchNum_++;
+        if (batchRet_ != SUCCESS) {
+            return batchRet_;
+        }
+        for (auto &property : properties) {
+            uint64_t templateId = 0;
+            property->GetUint64Value(AUTH_TEMPLATE_ID, templateId);
+            batchTemplateIds_.push_back(templateId);
+            results.push_back(SUCCESS);
+        }
+        return SUCCESS;
+    }
+
+    void Reset(int32_t batchRet)
+    {
+        batchRet_ = batchRet;
+        batchNum_ = 0;
+        singleNum_ = 0;
+        batchTemplateIds_.clear();
+    }
+
+    int32_t batchRet_;
+    uint32_t batchNum_ = 0;
+    uint32_t singleNum_ = 0;
+    std::vector<uint64_t> batchTemplateIds_;
+
+private:
+    sptr<IRemoteObject> remote_;
+};
+
+std::shared_ptr<ResAuthAttributes> CreateCondition(uint32_t authType, uint64_t templateId)
+{
+    auto condition = std::make_shared<ResAuthAttributes>();
+    condition->SetUint32Value(AUTH_TYPE, authType);
+    condition->SetUint64Value(AUTH_TEMPLATE_ID, templateId);
+    return condition;
+}
+
+uint64_t RegisterExecutor(AuthResManager &resManager, AuthType authType, sptr<FakeExecutorCallback> callback)
+{
+    auto executor = std::make_shared<ResAuthExecutor>();
+    std::vector<uint8_t> publicKey(PUBLIC_KEY_SIZE, static_cast<uint8_t>(authType));
+    executor->SetAuthType(authType);
+    executor->SetAuthAbility(0);
+    executor->SetExecutorSecLevel(ESL0);
+    executor->SetExecutorType(TYPE_ALL_IN_ONE);
+    executor->SetPublicKey(publicKey);
+    return resManager.Register(executor, callback);
+}
+
+// Conditions of both authTypes interleaved, with a hole.
+std::vector<std::shared_ptr<ResAuthAttributes>> CreateMixedConditions()
+{
+    return {
+        CreateCondition(PIN_AUTH_TYPE, 1),
+        CreateCondition(FACE_AUTH_TYPE, 2),
+        CreateCondition(PIN_AUTH_TYPE, 3),
+        nullptr,
+        CreateCondition(FACE_AUTH_TYPE, 5),
+    };
+}
+} // namespace
+
+class CoAuthManagerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+
+protected:
+    static AuthResManager resManager_;
+    static CoAuthManager coAuthManager_;
+    static sptr<FakeExecutorCallback> pinCallback_;
+    static sptr<FakeExecutorCallback> faceCallback_;
+};
+
+AuthResManager CoAuthManagerTest::resManager_;
+CoAuthManager CoAuthManagerTest::coAuthManager_;
+sptr<FakeExecutorCallback> CoAuthManagerTest::pinCallback_ = nullptr;
+sptr<FakeExecutorCallback> CoAuthManagerTest::faceCallback_ = nullptr;
+
+void CoAuthManagerTest::SetUpTestCase(void)
+{
+    ASSERT_EQ(Common::Init(), SUCCESS);
+    coAuthManager_.RegistResourceManager(&resManager_);
+    pinCallback_ = new FakeExecutorCallback(SUCCESS);
+    faceCallback_ = new FakeExecutorCallback(SUCCESS);
+    ASSERT_NE(RegisterExecutor(resManager_, PIN, pinCallback_), INVALID_EXECUTOR_ID);
+    ASSERT_NE(RegisterExecutor(resManager_, FACE, faceCallback_), INVALID_EXECUTOR_ID);
+}
+
+void CoAuthManagerTest::TearDownTestCase(void)
+{
+    (void)Common::Close();
+}
+
+// The cache is built into the test, so every test asks the executors.
+void CoAuthManagerTest::SetUp()
+{
+    ExecutorPropCache::GetInstance().InvalidateAll();
+    pinCallback_->Reset(SUCCESS);
+    faceCallback_->Reset(SUCCESS);
+}
+
+void CoAuthManagerTest::TearDown()
+{
+    ExecutorPropCache::GetInstance().InvalidateAll();
+}
+
+/**
+ * @tc.name: CoAuthManagerTest001
+ * @tc.desc: Test that each executor gets its conditions in one call and the values keep the order of the conditions.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CoAuthManagerTest, CoAuthManagerTest001, TestSize.Level0)
+{
+    auto conditions = CreateMixedConditions();
+    std::vector<std::shared_ptr<ResAuthAttributes>> values;
+    std::vector<int32_t> results;
+    EXPECT_EQ(coAuthManager_.GetExecutorProps(conditions, values, results), SUCCESS);
+    ASSERT_EQ(values.size(), conditions.size());
+    ASSERT_EQ(results.size(), conditions.size());
+    for (std::size_t i = 0; i < conditions.size(); i++) {
+        if (conditions[i] == nullptr) {
+            EXPECT_EQ(results[i], FAIL);
+            continue;
+        }
+        EXPECT_EQ(results[i], SUCCESS);
+        uint64_t templateId = 0;
+        conditions[i]->GetUint64Value(AUTH_TEMPLATE_ID, templateId);
+        uint32_t remainCount = 0;
+        values[i]->GetUint32Value(AUTH_REMAIN_COUNT, remainCount);
+        EXPECT_EQ(remainCount, templateId);
+    }
+    EXPECT_EQ(pinCallback_->batchNum_, 1u);
+    EXPECT_EQ(faceCallback_->batchNum_, 1u);
+    EXPECT_EQ(pinCallback_->singleNum_ + faceCallback_->singleNum_, 0u);
+    EXPECT_EQ(pinCallback_->batchTemplateIds_, std::vector<uint64_t>({ 1, 3 }));
+    EXPECT_EQ(faceCallback_->batchTemplateIds_, std::vector<uint64_t>({ 2, 5 }));
+}
+
+/**
+ * @tc.name: CoAuthManagerTest002
+ * @tc.desc: Test that only an executor without the batch call is asked one by one, a failed batch stays failed.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CoAuthManagerTest, CoAuthManagerTest002, TestSize.Level0)
+{
+    pinCallback_->Reset(ResIExecutorCallback::BATCH_NOT_SUPPORT);
+    faceCallback_->Reset(FAIL);
+    auto conditions = CreateMixedConditions();
+    std::vector<std::shared_ptr<ResAuthAttributes>> values;
+    std::vector<int32_t> results;
+    EXPECT_EQ(coAuthManager_.GetExecutorProps(conditions, values, results), SUCCESS);
+    ASSERT_EQ(results.size(), conditions.size());
+    EXPECT_EQ(results, std::vector<int32_t>({ SUCCESS, FAIL, SUCCESS, FAIL, FAIL }));
+    uint32_t remainCount = 0;
+    values[2]->GetUint32Value(AUTH_REMAIN_COUNT, remainCount);
+    EXPECT_EQ(remainCount, 3u);
+    EXPECT_EQ(pinCallback_->singleNum_, 2u);
+    EXPECT_EQ(faceCallback_->batchNum_, 1u);
+    EXPECT_EQ(faceCallback_->singleNum_, 0u);
+}
+
+/**
+ * @tc.name: CoAuthManagerTest003
+ * @tc.desc: Test that setting properties keeps the order of the conditions and falls back the same way.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CoAuthManagerTest, CoAuthManagerTest003, TestSize.Level0)
+{
+    auto conditions = CreateMixedConditions();
+    std::vector<int32_t> results;
+    EXPECT_EQ(coAuthManager_.SetExecutorProps(conditions, results), SUCCESS);
+    EXPECT_EQ(results, std::vector<int32_t>({ SUCCESS, SUCCESS, SUCCESS, FAIL, SUCCESS }));
+    EXPECT_EQ(pinCallback_->batchTemplateIds_, std::vector<uint64_t>({ 1, 3 }));
+    EXPECT_EQ(faceCallback_->batchTemplateIds_, std::vector<uint64_t>({ 2, 5 }));
+
+    pinCallback_->Reset(ResIExecutorCallback::BATCH_NOT_SUPPORT);
+    faceCallback_->Reset(FAIL);
+    EXPECT_EQ(coAuthManager_.SetExecutorProps(conditions, results), SUCCESS);
+    EXPECT_EQ(results, std::vector<int32_t>({ SUCCESS, FAIL, SUCCESS, FAIL, FAIL }));
+    EXPECT_EQ(pinCallback_->singleNum_, 2u);
+    EXPECT_EQ(faceCallback_->singleNum_, 0u);
+}
+
+/**
+ * @tc.name: CoAuthManagerTest004
+ * @tc.desc: Test that a batch larger than MAX_PROPERTY_BATCH_NUM is refused without asking the executors.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CoAuthManagerTest, CoAuthManagerTest004, TestSize.Level0)
+{
+    std::vector<std::shared_ptr<ResAuthAttributes>> conditions;
+    for (uint32_t i = 0; i <= MAX_PROPERTY_BATCH_NUM; i++) {
+        conditions.push_back(CreateCondition(PIN_AUTH_TYPE, i));
+    }
+    std::vector<std::shared_ptr<ResAuthAttributes>> values;
+    std::vector<int32_t> results;
+    EXPECT_EQ(coAuthManager_.GetExecutorProps(conditions, values, results), INVALID_PARAMETERS);
+    EXPECT_EQ(coAuthManager_.SetExecutorProps(conditions, results), INVALID_PARAMETERS);
+    EXPECT_EQ(pinCallback_->batchNum_ + pinCallback_->singleNum_, 0u);
+}
+} // namespace CoAuth
+} // namespace UserIAM
+} // namespace OHOS
@@ -14,6 +14,7 @@
  */
 
 #include "coauth_test.h"
+#include <functional>
 #include <gtest/gtest.h>
 
 using namespace testing::ext;
@@ -570,6 +571,114 @@ HWTEST_F(CoAuthTest, UseriamUtTest018, TestSize.Level0)
     sleep(5);
     SUCCEED();
 }
+
+/**
+ * @tc.name: UseriamUtTest019
+ * @tc.desc: Test that registering a callback again keeps its executorId and that Unregister forgets it once.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CoAuthTest, UseriamUtTest019, TestSize.Level0)
+{
+    COAUTH_HILOGD(MODULE_INNERKIT, "UseriamUtTest019 start");
+    std::shared_ptr<AuthResPool::AuthExecutor> executorInfo = std::make_shared<AuthResPool::AuthExecutor>();
+    executorInfo->SetAuthType(PIN);
+    executorInfo->SetAuthAbility(1);
+    executorInfo->SetExecutorSecLevel(ESL0);
+    executorInfo->SetExecutorType(TYPE_CO_AUTH);
+
+    std::vector<uint8_t> publicKey(32, '1');
+    executorInfo->SetPublicKey(publicKey);
+    class MyExecutorCallback : public AuthResPool::ExecutorCallback {
+    public:
+        virtual ~MyExecutorCallback() {};
+        void OnMessengerReady(const sptr<AuthResPool::IExecutorMessenger> &messenger)override {
+            return;
+        }
+        int32_t OnBeginExecute(uint64_t scheduleId, std::vector<uint8_t> &publicKey,
+                                    std::shared_ptr<AuthResPool::AuthAttributes> commandAttrs)override {
+            return SUCCESS;
+        }
+        int32_t OnEndExecute(uint64_t scheduleId, std::shared_ptr<AuthResPool::AuthAttributes> consumerAttr)override {
+            return SUCCESS;
+        }
+        int32_t OnSetProperty(std::shared_ptr<AuthResPool::AuthAttributes> properties)override {
+            return SUCCESS;
+        }
+        int32_t OnGetProperty(std::shared_ptr<AuthResPool::AuthAttributes> conditions,
+                              std::shared_ptr<AuthResPool::AuthAttributes> values)override {
+            return SUCCESS;
+        }
+    };
+    std::shared_ptr<AuthResPool::ExecutorCallback> callback = std::make_shared<MyExecutorCallback>();
+    std::shared_ptr<AuthResPool::ExecutorCallback> otherCallback = std::make_shared<MyExecutorCallback>();
+    AuthResPool::AuthExecutorRegistry &registry = AuthResPool::AuthExecutorRegistry::GetInstance();
+    uint64_t executorId = registry.Register(executorInfo, callback);
+    EXPECT_LE(10000, executorId);
+    EXPECT_EQ(executorId, registry.Register(executorInfo, callback));
+
+    EXPECT_EQ(FAIL, registry.Unregister(otherCallback));
+    EXPECT_EQ(FAIL, registry.Unregister(nullptr));
+    EXPECT_EQ(SUCCESS, registry.Unregister(callback));
+    EXPECT_EQ(FAIL, registry.Unregister(callback));
+
+/**
+ * @tc.name: UseriamUtTest020
+ * @tc.desc: Test that an executor may register another executor from OnMessengerReady.
+ * @tc.type: FUNC
+ */
+HWTEST_F(CoAuthTest, UseriamUtTest020, TestSize.Level0)
+{
+    COAUTH_HILOGD(MODULE_INNERKIT, "UseriamUtTest020 start");
+    std::shared_ptr<AuthResPool::AuthExecutor> executorInfo = std::make_shared<AuthResPool::AuthExecutor>();
+    executorInfo->SetAuthType(PIN);
+    executorInfo->SetAuthAbility(1);
+    executorInfo->SetExecutorSecLevel(ESL0);
+    executorInfo->SetExecutorType(TYPE_CO_AUTH);
+
+    std::vector<uint8_t> publicKey(32, '1');
+    executorInfo->SetPublicKey(publicKey);
+    class MyExecutorCallback : public AuthResPool::ExecutorCallback {
+    public:
+        explicit MyExecutorCallback(std::function<void()> onReady) : onReady_(onReady) {}
+        virtual ~MyExecutorCallback() {};
+        void OnMessengerReady(const sptr<AuthResPool::IExecutorMessenger> &messenger)override {
+            if (onReady_ != nullptr) {
+                onReady_();
+            }
+        }
+        int32_t OnBeginExecute(uint64_t scheduleId, std::vector<uint8_t> &publicKey,
+                                    std::shared_ptr<AuthResPool::AuthAttributes> commandAttrs)override {
+            return SUCCESS;
+        }
+        int32_t OnEndExecute(uint64_t scheduleId, std::shared_ptr<AuthResPool::AuthAttributes> consumerAttr)override {
+            return SUCCESS;
+        }
+        int32_t OnSetProperty(std::shared_ptr<AuthResPool::AuthAttributes> properties)override {
+            return SUCCESS;
+        }
+        int32_t OnGetProperty(std::shared_ptr<AuthResPool::AuthAttributes> conditions,
+                              std::shared_ptr<AuthResPool::AuthAttributes> values)override {
+            return SUCCESS;
+        }
+
+    private:
+        std::function<void()> onReady_;
+    };
+    AuthResPool::AuthExecutorRegistry &registry = AuthResPool::AuthExecutorRegistry::GetInstance();
+    std::shared_ptr<AuthResPool::ExecutorCallback> secondCallback = std::make_shared<MyExecutorCallback>(nullptr);
+    uint64_t secondExecutorId = 0;
+    std::shared_ptr<AuthResPool::ExecutorCallback> firstCallback = std::make_shared<MyExecutorCallback>(
+        [&registry, &executorInfo, &secondCallback, &secondExecutorId]() {
+            secondExecutorId = registry.Register(executorInfo, secondCallback);
+        });
+    // The service calls OnMessengerReady back before Register returns.
+    uint64_t firstExecutorId = registry.Register(executorInfo, firstCallback);
+    EXPECT_LE(10000, firstExecutorId);
+    EXPECT_LE(10000, secondExecutorId);
+    EXPECT_EQ(SUCCESS, registry.Unregister(firstCallback));
+    EXPECT_EQ(SUCCESS, registry.Unregister(secondCallback));
+}
+}
 }
 }
 }
\ No newline at end of file
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "executor_prop_cache.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace UserIAM {
+namespace CoAuth {
+namespace {
+constexpr uint32_t PIN_AUTH_TYPE = 1;
+constexpr uint32_t FACE_AUTH_TYPE = 2;
+constexpr uint64_t TEMPLATE_ID = 9;
+constexpr uint32_t PROPERTY_MODE = 2;
+constexpr uint32_t REMAIN_COUNT = 5;
+
+struct CachedQuery {
+    AuthResPool::AuthAttributes conditions;
+    std::vector<uint8_t> packedConditions;
+};
+
+void InitQuery(CachedQuery &query, uint32_t authType)
+{
+    query.conditions.SetUint32Value(AUTH_TYPE, authType);
+    query.conditions.SetUint64Value(AUTH_TEMPLATE_ID, TEMPLATE_ID);
+    query.conditions.SetUint32Value(AUTH_PROPERTY_MODE, PROPERTY_MODE);
+    query.conditions.Pack(query.packedConditions);
+}
+
+void SaveQuery(CachedQuery &query)
+{
+    auto values = std::make_shared<AuthResPool::AuthAttributes>();
+    values->SetUint32Value(AUTH_REMAIN_COUNT, REMAIN_COUNT);
+    ExecutorPropCache::GetInstance().Save(query.conditions, query.packedConditions, values);
+}
+
+bool FindQuery(CachedQuery &query)
+{
+    auto values = std::make_shared<AuthResPool::AuthAttributes>();
+    return ExecutorPropCache::GetInstance().Find(query.conditions, query.packedConditions, values);
+}
+} // namespace
+
+class ExecutorPropCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void ExecutorPropCacheTest::SetUpTestCase(void)
+{
+}
+
+void ExecutorPropCacheTest::TearDownTestCase(void)
+{
+}
+
+void ExecutorPropCacheTest::SetUp()
+{
+    ExecutorPropCache::GetInstance().InvalidateAll();
+}
+
+void ExecutorPropCacheTest::TearDown()
+{
+    ExecutorPropCache::GetInstance().InvalidateAll();
+}
+
+/**
+ * @tc.name: ExecutorPropCacheTest001
+ * @tc.desc: Test that a saved result is returned only for byte identical conditions.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ExecutorPropCacheTest, ExecutorPropCacheTest001, TestSize.Level0)
+{
+    CachedQuery query;
+    InitQuery(query, PIN_AUTH_TYPE);
+    EXPECT_FALSE(FindQuery(query));
+    SaveQuery(query);
+
+    auto values = std::make_shared<AuthResPool::AuthAttributes>();
+    ASSERT_TRUE(ExecutorPropCache::GetInstance().Find(query.conditions, query.packedConditions, values));
+    uint32_t remainCount = 0;
+    values->GetUint32Value(AUTH_REMAIN_COUNT, remainCount);
+    EXPECT_EQ(remainCount, REMAIN_COUNT);
+
+    std::vector<uint8_t> otherConditions = query.packedConditions;
+    otherConditions.push_back(0);
+    EXPECT_FALSE(ExecutorPropCache::GetInstance().Find(query.conditions, otherConditions, values));
+    EXPECT_FALSE(ExecutorPropCache::GetInstance().Find(query.conditions, query.packedConditions, nullptr));
+}
+
+/**
+ * @tc.name: ExecutorPropCacheTest002
+ * @tc.desc: Test that invalidating an authType drops only its entries and that all entries can be dropped.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ExecutorPropCacheTest, ExecutorPropCacheTest002, TestSize.Level0)
+{
+    CachedQuery pinQuery;
+    InitQuery(pinQuery, PIN_AUTH_TYPE);
+    CachedQuery faceQuery;
+    InitQuery(faceQuery, FACE_AUTH_TYPE);
+    SaveQuery(pinQuery);
+    SaveQuery(faceQuery);
+
+    ExecutorPropCache::GetInstance().Invalidate(FACE_AUTH_TYPE);
+    EXPECT_TRUE(FindQuery(pinQuery));
+    EXPECT_FALSE(FindQuery(faceQuery));
+
+    SaveQuery(faceQuery);
+    ExecutorPropCache::GetInstance().InvalidateAll();
+    EXPECT_FALSE(FindQuery(pinQuery));
+    EXPECT_FALSE(FindQuery(faceQuery));
+}
+} // namespace CoAuth
+} // namespace UserIAM
+} // namespace OHOS
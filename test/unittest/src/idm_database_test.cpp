@@ -0,0 +1,439 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
+
+extern "C" {
+#include "adaptor_file.h"
+#include "adaptor_memory.h"
+#include "idm_database.h"
+#include "lock.h"
+}
+
+using namespace testing::ext;
+namespace OHOS {
+namespace UserIAM {
+namespace {
+const char *USER_INFO_FILE = "/data/useriam/userinfo";
+const char *USER_INFO_BACKUP = "/data/useriam/userinfo.bak";
+const char *USER_INFO_TEMP = "/data/useriam/userinfo.tmp";
+const char *USER_INFO_MOVED = "/data/useriam/userinfo.moved";
+// More users than the lazy loaded database keeps resident.
+constexpr int32_t USER_NUM = 50;
+constexpr uint64_t PIN_TEMPLATE_BASE = 100;
+constexpr uint64_t FACE_TEMPLATE_BASE = 1000;
+constexpr int32_t PERSIST_WAIT_TIMES = 50;
+constexpr std::chrono::milliseconds PERSIST_WAIT_INTERVAL(20);
+// As in idm_database.c.
+constexpr int32_t MAX_RESIDENT_USER = 8;
+// Longer than the coalescing window of the persist worker.
+constexpr std::chrono::milliseconds PERSIST_WINDOW_PASSED(300);
+
+ResultCode CountCredential(const CredentialInfoHal *credentialInfo, void *visitorContext)
+{
+    (void)credentialInfo;
+    (*static_cast<uint32_t *>(visitorContext))++;
+    return RESULT_SUCCESS;
+}
+
+void AddPin(int32_t userId)
+{
+    CredentialInfoHal pin = {};
+    pin.authType = PIN_AUTH;
+    pin.templateId = PIN_TEMPLATE_BASE + userId;
+    ASSERT_EQ(AddCredentialInfo(userId, &pin), RESULT_SUCCESS);
+}
+
+bool HasPin(int32_t userId)
+{
+    CredentialInfoHal credentialInfo = {};
+    return QueryCredentialInfo(userId, PIN_AUTH, &credentialInfo) == RESULT_SUCCESS;
+}
+
+off_t GetUserInfoFileSize()
+{
+    struct stat fileStat = {};
+    if (stat(USER_INFO_FILE, &fileStat) != 0) {
+        return -1;
+    }
+    return fileStat.st_size;
+}
+
+void WaitUserInfoFile()
+{
+    for (int32_t i = 0; i < PERSIST_WAIT_TIMES && access(USER_INFO_FILE, F_OK) != 0; i++) {
+        std::this_thread::sleep_for(PERSIST_WAIT_INTERVAL);
+    }
+}
+
+void AddUsers()
+{
+    for (int32_t userId = 0; userId < USER_NUM; userId++) {
+        CredentialInfoHal pin = {};
+        pin.authType = PIN_AUTH;
+        pin.templateId = PIN_TEMPLATE_BASE + userId;
+        ASSERT_EQ(AddCredentialInfo(userId, &pin), RESULT_SUCCESS);
+        CredentialInfoHal face = {};
+        face.authType = FACE_AUTH;
+        face.templateId = FACE_TEMPLATE_BASE + userId;
+        ASSERT_EQ(AddCredentialInfo(userId, &face), RESULT_SUCCESS);
+    }
+}
+} // namespace
+
+class IdmDatabaseTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+// The tests start from an empty database, the user file of the device is put back afterwards.
+void IdmDatabaseTest::SetUpTestCase(void)
+{
+    (void)rename(USER_INFO_FILE, USER_INFO_BACKUP);
+}
+
+void IdmDatabaseTest::TearDownTestCase(void)
+{
+    (void)remove(USER_INFO_FILE);
+    (void)rename(USER_INFO_BACKUP, USER_INFO_FILE);
+}
+
+// The database is used under the global lock like the services do, so the persist worker never runs in between.
+void IdmDatabaseTest::SetUp()
+{
+    (void)remove(USER_INFO_FILE);
+    GlobalLock();
+    ASSERT_EQ(InitUserInfoList(), RESULT_SUCCESS);
+}
+
+void IdmDatabaseTest::TearDown()
+{
+    DestroyUserInfoList();
+    GlobalUnLock();
+}
+
+/**
+ * @tc.name: IdmDatabaseTest001
+ * @tc.desc: Test that every user is found after it was evicted and after the database is loaded again.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmDatabaseTest, IdmDatabaseTest001, TestSize.Level0)
+{
+    AddUsers();
+    for (int32_t round = 0; round < 2; round++) {
+        for (int32_t userId = USER_NUM - 1; userId >= 0; userId--) {
+            CredentialInfoHal credentialInfo = {};
+            EXPECT_EQ(QueryCredentialInfo(userId, FACE_AUTH, &credentialInfo), RESULT_SUCCESS);
+            EXPECT_EQ(credentialInfo.templateId, FACE_TEMPLATE_BASE + userId);
+        }
+        uint32_t num = 0;
+        EXPECT_EQ(VisitCredentialFromExecutor(PIN_AUTH, CountCredential, &num), RESULT_SUCCESS);
+        EXPECT_EQ(num, static_cast<uint32_t>(USER_NUM));
+        ASSERT_EQ(InitUserInfoList(), RESULT_SUCCESS);
+    }
+}
+
+/**
+ * @tc.name: IdmDatabaseTest002
+ * @tc.desc: Test that a user deleted while it is not resident stays deleted after a reload.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmDatabaseTest, IdmDatabaseTest002, TestSize.Level0)
+{
+    AddUsers();
+    ASSERT_EQ(InitUserInfoList(), RESULT_SUCCESS);
+    CredentialInfoHal *credentialInfos = nullptr;
+    uint32_t num = 0;
+    EXPECT_EQ(DeleteUserInfo(3, &credentialInfos, &num), RESULT_SUCCESS);
+    EXPECT_EQ(num, 2u);
+    Free(credentialInfos);
+
+    ASSERT_EQ(InitUserInfoList(), RESULT_SUCCESS);
+    CredentialInfoHal credentialInfo = {};
+    EXPECT_EQ(QueryCredentialInfo(3, PIN_AUTH, &credentialInfo), RESULT_NOT_FOUND);
+    EXPECT_EQ(QueryCredentialInfo(4, PIN_AUTH, &credentialInfo), RESULT_SUCCESS);
+    EXPECT_EQ(credentialInfo.templateId, PIN_TEMPLATE_BASE + 4);
+}
+
+/**
+ * @tc.name: IdmDatabaseTest003
+ * @tc.desc: Test that the changes of a transaction are written to the file only by its commit.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmDatabaseTest, IdmDatabaseTest003, TestSize.Level0)
+{
+    ASSERT_EQ(BeginUserInfoTransaction(), RESULT_SUCCESS);
+    EXPECT_EQ(BeginUserInfoTransaction(), RESULT_BUSY);
+    AddPin(1);
+    AddPin(2);
+    EXPECT_NE(access(USER_INFO_FILE, F_OK), 0);
+    ASSERT_EQ(CommitUserInfoTransaction(), RESULT_SUCCESS);
+    EXPECT_EQ(access(USER_INFO_FILE, F_OK), 0);
+    EXPECT_EQ(CommitUserInfoTransaction(), RESULT_BAD_PARAM);
+
+    ASSERT_EQ(InitUserInfoList(), RESULT_SUCCESS);
+    EXPECT_TRUE(HasPin(1));
+    EXPECT_TRUE(HasPin(2));
+}
+
+/**
+ * @tc.name: IdmDatabaseTest004
+ * @tc.desc: Test that a rollback restores the users as they were before the transaction.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmDatabaseTest, IdmDatabaseTest004, TestSize.Level0)
+{
+    AddPin(1);
+    ASSERT_EQ(BeginUserInfoTransaction(), RESULT_SUCCESS);
+    AddPin(2);
+    CredentialInfoHal *credentialInfos = nullptr;
+    uint32_t num = 0;
+    EXPECT_EQ(DeleteUserInfo(1, &credentialInfos, &num), RESULT_SUCCESS);
+    Free(credentialInfos);
+    EXPECT_FALSE(HasPin(1));
+    ASSERT_EQ(RollbackUserInfoTransaction(), RESULT_SUCCESS);
+    EXPECT_TRUE(HasPin(1));
+    EXPECT_FALSE(HasPin(2));
+    EXPECT_EQ(RollbackUserInfoTransaction(), RESULT_BAD_PARAM);
+}
+
+/**
+ * @tc.name: IdmDatabaseTest005
+ * @tc.desc: Test that a commit which can't be written rolls the transaction back.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmDatabaseTest, IdmDatabaseTest005, TestSize.Level0)
+{
+    AddPin(1);
+    ASSERT_EQ(BeginUserInfoTransaction(), RESULT_SUCCESS);
+    AddPin(2);
+    // The file is written through a temporary file, a directory in its place makes the write fail.
+    ASSERT_EQ(mkdir(USER_INFO_TEMP, S_IRWXU), 0);
+    EXPECT_NE(CommitUserInfoTransaction(), RESULT_SUCCESS);
+    (void)rmdir(USER_INFO_TEMP);
+    EXPECT_TRUE(HasPin(1));
+    EXPECT_FALSE(HasPin(2));
+    ASSERT_EQ(BeginUserInfoTransaction(), RESULT_SUCCESS);
+    EXPECT_EQ(CommitUserInfoTransaction(), RESULT_SUCCESS);
+}
+
+/**
+ * @tc.name: IdmDatabaseTest006
+ * @tc.desc: Test that the changes of a transaction are seen inside it only, and are dropped without reading the file.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmDatabaseTest, IdmDatabaseTest006, TestSize.Level0)
+{
+    AddPin(1);
+    ASSERT_EQ(FlushUserInfo(), RESULT_SUCCESS);
+    ASSERT_EQ(BeginUserInfoTransaction(), RESULT_SUCCESS);
+    AddPin(2);
+    CredentialInfoHal *credentialInfos = nullptr;
+    uint32_t num = 0;
+    EXPECT_EQ(DeleteUserInfo(1, &credentialInfos, &num), RESULT_SUCCESS);
+    Free(credentialInfos);
+    EXPECT_FALSE(HasPin(1));
+    EXPECT_TRUE(HasPin(2));
+    num = 0;
+    EXPECT_EQ(VisitCredentialFromExecutor(PIN_AUTH, CountCredential, &num), RESULT_SUCCESS);
+    EXPECT_EQ(num, 1u);
+
+    ASSERT_EQ(rename(USER_INFO_FILE, USER_INFO_MOVED), 0);
+    EXPECT_EQ(RollbackUserInfoTransaction(), RESULT_SUCCESS);
+    EXPECT_TRUE(HasPin(1));
+    EXPECT_FALSE(HasPin(2));
+    ASSERT_EQ(rename(USER_INFO_MOVED, USER_INFO_FILE), 0);
+}
+
+/**
+ * @tc.name: IdmDatabaseTest007
+ * @tc.desc: Test that a flush writes the pending changes, so nothing is left to write on destroy.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmDatabaseTest, IdmDatabaseTest007, TestSize.Level0)
+{
+    AddPin(1);
+    AddPin(2);
+    ASSERT_EQ(FlushUserInfo(), RESULT_SUCCESS);
+    ASSERT_EQ(rename(USER_INFO_FILE, USER_INFO_MOVED), 0);
+    DestroyUserInfoList();
+    EXPECT_NE(access(USER_INFO_FILE, F_OK), 0);
+    ASSERT_EQ(rename(USER_INFO_MOVED, USER_INFO_FILE), 0);
+
+    ASSERT_EQ(InitUserInfoList(), RESULT_SUCCESS);
+    EXPECT_TRUE(HasPin(1));
+    EXPECT_TRUE(HasPin(2));
+}
+
+/**
+ * @tc.name: IdmDatabaseTest008
+ * @tc.desc: Test that a change is written to the file without a flush once the global lock is released.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmDatabaseTest, IdmDatabaseTest008, TestSize.Level0)
+{
+    AddPin(1);
+#ifdef IDM_ASYNC_PERSIST
+    // The worker needs the global lock, so nothing is written while the test holds it.
+    std::this_thread::sleep_for(PERSIST_WINDOW_PASSED);
+    EXPECT_NE(access(USER_INFO_FILE, F_OK), 0);
+#endif
+    GlobalUnLock();
+    WaitUserInfoFile();
+    GlobalLock();
+    EXPECT_EQ(access(USER_INFO_FILE, F_OK), 0);
+}
+
+#ifdef IDM_ASYNC_PERSIST
+/**
+ * @tc.name: IdmDatabaseTest009
+ * @tc.desc: Test that destroying the list with the global lock held stops the worker and writes the pending change.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmDatabaseTest, IdmDatabaseTest009, TestSize.Level0)
+{
+    AddPin(1);
+    std::this_thread::sleep_for(PERSIST_WINDOW_PASSED);
+    EXPECT_NE(access(USER_INFO_FILE, F_OK), 0);
+    DestroyUserInfoList();
+    EXPECT_EQ(access(USER_INFO_FILE, F_OK), 0);
+
+    ASSERT_EQ(InitUserInfoList(), RESULT_SUCCESS);
+    EXPECT_TRUE(HasPin(1));
+    AddPin(2);
+    GlobalUnLock();
+    std::this_thread::sleep_for(PERSIST_WINDOW_PASSED);
+    GlobalLock();
+    ASSERT_EQ(InitUserInfoList(), RESULT_SUCCESS);
+    EXPECT_TRUE(HasPin(2));
+}
+#endif
+
+#ifdef IDM_LAZY_LOAD
+/**
+ * @tc.name: IdmDatabaseTest010
+ * @tc.desc: Test that only the most recently used users stay resident once the user file is written.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmDatabaseTest, IdmDatabaseTest010, TestSize.Level0)
+{
+    AddUsers();
+    ASSERT_EQ(FlushUserInfo(), RESULT_SUCCESS);
+    // Without the file only the resident users are found. A user which is not found costs a resident one.
+    ASSERT_EQ(rename(USER_INFO_FILE, USER_INFO_MOVED), 0);
+    int32_t residentNum = 0;
+    for (int32_t userId = USER_NUM - 1; userId >= 0 && HasPin(userId); userId--) {
+        residentNum++;
+    }
+    ASSERT_EQ(rename(USER_INFO_MOVED, USER_INFO_FILE), 0);
+    EXPECT_EQ(residentNum, MAX_RESIDENT_USER);
+}
+
+/**
+ * @tc.name: IdmDatabaseTest011
+ * @tc.desc: Test that a changed user is not evicted and that evictions don't write the file.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmDatabaseTest, IdmDatabaseTest011, TestSize.Level0)
+{
+    AddUsers();
+    ASSERT_EQ(FlushUserInfo(), RESULT_SUCCESS);
+    CredentialInfoHal face = {};
+    ASSERT_EQ(QueryCredentialInfo(USER_NUM - 1, FACE_AUTH, &face), RESULT_SUCCESS);
+    off_t fileSize = GetUserInfoFileSize();
+    CredentialInfoHal deleted = {};
+    ASSERT_EQ(DeleteCredentialInfo(USER_NUM - 1, face.credentialId, &deleted), RESULT_SUCCESS);
+#ifdef IDM_ASYNC_PERSIST
+    EXPECT_EQ(GetUserInfoFileSize(), fileSize);
+    fileSize = GetUserInfoFileSize();
+#else
+    EXPECT_LT(GetUserInfoFileSize(), fileSize);
+    fileSize = GetUserInfoFileSize();
+#endif
+    for (int32_t userId = 0; userId < USER_NUM - 1; userId++) {
+        EXPECT_TRUE(HasPin(userId));
+    }
+    EXPECT_EQ(GetUserInfoFileSize(), fileSize);
+    CredentialInfoHal credentialInfo = {};
+    EXPECT_EQ(QueryCredentialInfo(USER_NUM - 1, FACE_AUTH, &credentialInfo), RESULT_NOT_FOUND);
+    EXPECT_TRUE(HasPin(USER_NUM - 1));
+}
+
+/**
+ * @tc.name: IdmDatabaseTest012
+ * @tc.desc: Test that evicted users are loaded and visited without a file operator which reads by offset.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmDatabaseTest, IdmDatabaseTest012, TestSize.Level0)
+{
+    AddUsers();
+    ASSERT_EQ(InitUserInfoList(), RESULT_SUCCESS);
+    FileOperator *fileOperator = GetFileOperator(DEFAULT_FILE_OPERATOR);
+    ASSERT_NE(fileOperator, nullptr);
+    auto readFileByOffset = fileOperator->readFileByOffset;
+    fileOperator->readFileByOffset = nullptr;
+    uint32_t num = 0;
+    EXPECT_EQ(VisitCredentialFromExecutor(FACE_AUTH, CountCredential, &num), RESULT_SUCCESS);
+    EXPECT_EQ(num, static_cast<uint32_t>(USER_NUM));
+    for (int32_t userId = 0; userId < USER_NUM; userId++) {
+        EXPECT_TRUE(HasPin(userId));
+    }
+    fileOperator->readFileByOffset = readFileByOffset;
+}
+#endif
+
+/**
+ * @tc.name: IdmDatabaseTest013
+ * @tc.desc: Test that a transaction changing every user is written once on commit and is loaded again.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmDatabaseTest, IdmDatabaseTest013, TestSize.Level0)
+{
+    AddUsers();
+    ASSERT_EQ(FlushUserInfo(), RESULT_SUCCESS);
+    ASSERT_EQ(InitUserInfoList(), RESULT_SUCCESS);
+    off_t fileSize = GetUserInfoFileSize();
+    ASSERT_EQ(BeginUserInfoTransaction(), RESULT_SUCCESS);
+    for (int32_t userId = 0; userId < USER_NUM; userId++) {
+        CredentialInfoHal face = {};
+        ASSERT_EQ(QueryCredentialInfo(userId, FACE_AUTH, &face), RESULT_SUCCESS);
+        CredentialInfoHal deleted = {};
+        ASSERT_EQ(DeleteCredentialInfo(userId, face.credentialId, &deleted), RESULT_SUCCESS);
+    }
+    EXPECT_EQ(GetUserInfoFileSize(), fileSize);
+    ASSERT_EQ(CommitUserInfoTransaction(), RESULT_SUCCESS);
+    EXPECT_LT(GetUserInfoFileSize(), fileSize);
+
+    ASSERT_EQ(InitUserInfoList(), RESULT_SUCCESS);
+    uint32_t num = 0;
+    EXPECT_EQ(VisitCredentialFromExecutor(FACE_AUTH, CountCredential, &num), RESULT_SUCCESS);
+    EXPECT_EQ(num, 0u);
+    for (int32_t userId = 0; userId < USER_NUM; userId++) {
+        EXPECT_TRUE(HasPin(userId));
+    }
+}
+} // namespace UserIAM
+} // namespace OHOS
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+
+extern "C" {
+#include "adaptor_memory.h"
+#include "idm_file_manager.h"
+}
+
+using namespace testing::ext;
+namespace OHOS {
+namespace UserIAM {
+namespace {
+const char *USER_INFO_FILE = "/data/useriam/userinfo";
+const char *USER_INFO_BACKUP = "/data/useriam/userinfo.bak";
+constexpr uint32_t USER_NUM = 5;
+constexpr uint64_t SEC_UID_BASE = 500;
+// Version and user number.
+constexpr uint32_t FILE_HEAD_LEN = 8;
+
+// User i has i + 1 credentials and one enrolled info, so the records have different lengths.
+UserInfo *CreateUser(uint32_t index)
+{
+    UserInfo *user = InitUserInfoNode();
+    if (user == nullptr) {
+        return nullptr;
+    }
+    user->userId = static_cast<int32_t>(index);
+    user->secUid = SEC_UID_BASE + index;
+    for (uint32_t i = 0; i <= index; i++) {
+        CredentialInfoHal *credential = static_cast<CredentialInfoHal *>(Malloc(sizeof(CredentialInfoHal)));
+        if (credential == nullptr) {
+            DestroyUserInfoNode(user);
+            return nullptr;
+        }
+        *credential = {};
+        credential->credentialId = i;
+        credential->authType = PIN_AUTH;
+        (void)user->credentialInfoList->insert(user->credentialInfoList, credential);
+    }
+    EnrolledInfoHal *enrolled = static_cast<EnrolledInfoHal *>(Malloc(sizeof(EnrolledInfoHal)));
+    if (enrolled == nullptr) {
+        DestroyUserInfoNode(user);
+        return nullptr;
+    }
+    enrolled->authType = PIN_AUTH;
+    enrolled->enrolledId = index;
+    (void)user->enrolledInfoList->insert(user->enrolledInfoList, enrolled);
+    return user;
+}
+
+LinkedList *CreateUserList()
+{
+    LinkedList *userList = CreateLinkedList(DestroyUserInfoNode);
+    if (userList == nullptr) {
+        return nullptr;
+    }
+    for (uint32_t i = 0; i < USER_NUM; i++) {
+        UserInfo *user = CreateUser(i);
+        if (user == nullptr) {
+            DestroyLinkedList(userList);
+            return nullptr;
+        }
+        (void)userList->insert(userList, user);
+    }
+    return userList;
+}
+
+// userId, secUid, credential number, credentials, enrolled number and enrolled infos.
+uint32_t GetUserSize(uint32_t credentialNum, uint32_t enrolledNum)
+{
+    return sizeof(int32_t) + sizeof(uint64_t) + sizeof(uint32_t) + credentialNum * sizeof(CredentialInfoHal) +
+        sizeof(uint32_t) + enrolledNum * sizeof(EnrolledInfoHal);
+}
+
+UserInfo *FindUser(LinkedList *userList, int32_t userId)
+{
+    for (LinkedListNode *node = userList->head; node != nullptr; node = node->next) {
+        UserInfo *user = static_cast<UserInfo *>(node->data);
+        if (user->userId == userId) {
+            return user;
+        }
+    }
+    return nullptr;
+}
+} // namespace
+
+class IdmFileManagerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void IdmFileManagerTest::SetUpTestCase(void)
+{
+    (void)rename(USER_INFO_FILE, USER_INFO_BACKUP);
+}
+
+void IdmFileManagerTest::TearDownTestCase(void)
+{
+    (void)remove(USER_INFO_FILE);
+    (void)rename(USER_INFO_BACKUP, USER_INFO_FILE);
+}
+
+void IdmFileManagerTest::SetUp()
+{
+    (void)remove(USER_INFO_FILE);
+}
+
+void IdmFileManagerTest::TearDown()
+{
+}
+
+/**
+ * @tc.name: IdmFileManagerTest001
+ * @tc.desc: Test that the index locates every user record written to the file.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmFileManagerTest, IdmFileManagerTest001, TestSize.Level0)
+{
+    LinkedList *userList = CreateUserList();
+    ASSERT_NE(userList, nullptr);
+    ASSERT_EQ(UpdateFileInfo(userList), RESULT_SUCCESS);
+    DestroyLinkedList(userList);
+
+    UserInfoIndex *userIndex = LoadFileIndex();
+    ASSERT_NE(userIndex, nullptr);
+    ASSERT_EQ(userIndex->recordNum, USER_NUM);
+    for (uint32_t i = 0; i < userIndex->recordNum; i++) {
+        EXPECT_FALSE(userIndex->records[i].resident);
+        UserInfo *user = LoadUserInfoFromIndex(userIndex, i);
+        ASSERT_NE(user, nullptr);
+        EXPECT_EQ(user->userId, userIndex->records[i].userId);
+        EXPECT_EQ(user->secUid, SEC_UID_BASE + user->userId);
+        EXPECT_EQ(user->credentialInfoList->getSize(user->credentialInfoList),
+            static_cast<uint32_t>(user->userId) + 1);
+        EXPECT_EQ(user->enrolledInfoList->getSize(user->enrolledInfoList), 1u);
+        DestroyUserInfoNode(user);
+    }
+    EXPECT_EQ(LoadUserInfoFromIndex(userIndex, USER_NUM), nullptr);
+    DestroyUserInfoIndex(userIndex);
+}
+
+/**
+ * @tc.name: IdmFileManagerTest002
+ * @tc.desc: Test that writing the resident users keeps the records of the users that are not loaded.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmFileManagerTest, IdmFileManagerTest002, TestSize.Level0)
+{
+    LinkedList *userList = CreateUserList();
+    ASSERT_NE(userList, nullptr);
+    ASSERT_EQ(UpdateFileInfo(userList), RESULT_SUCCESS);
+    DestroyLinkedList(userList);
+
+    UserInfoIndex *userIndex = LoadFileIndex();
+    ASSERT_NE(userIndex, nullptr);
+    LinkedList *residentList = CreateLinkedList(DestroyUserInfoNode);
+    ASSERT_NE(residentList, nullptr);
+    UserInfo *user = LoadUserInfoFromIndex(userIndex, 1);
+    ASSERT_NE(user, nullptr);
+    userIndex->records[1].resident = true;
+    int32_t residentUserId = user->userId;
+    user->secUid = 0;
+    (void)residentList->insert(residentList, user);
+    EXPECT_EQ(UpdateFileInfoWithIndex(residentList, userIndex), RESULT_SUCCESS);
+    DestroyLinkedList(residentList);
+    DestroyUserInfoIndex(userIndex);
+
+    userList = LoadFileInfo();
+    ASSERT_NE(userList, nullptr);
+    EXPECT_EQ(userList->getSize(userList), USER_NUM);
+    for (uint32_t i = 0; i < USER_NUM; i++) {
+        user = FindUser(userList, static_cast<int32_t>(i));
+        ASSERT_NE(user, nullptr);
+        EXPECT_EQ(user->secUid, (user->userId == residentUserId) ? 0 : SEC_UID_BASE + i);
+    }
+    DestroyLinkedList(userList);
+}
+
+/**
+ * @tc.name: IdmFileManagerTest003
+ * @tc.desc: Test that the file holds exactly the written users and that they are read back unchanged.
+ * @tc.type: FUNC
+ */
+HWTEST_F(IdmFileManagerTest, IdmFileManagerTest003, TestSize.Level0)
+{
+    LinkedList *userList = CreateUserList();
+    ASSERT_NE(userList, nullptr);
+    ASSERT_EQ(UpdateFileInfo(userList), RESULT_SUCCESS);
+    DestroyLinkedList(userList);
+
+    uint32_t expectSize = FILE_HEAD_LEN;
+    for (uint32_t i = 0; i < USER_NUM; i++) {
+        expectSize += GetUserSize(i + 1, 1);
+    }
+    struct stat fileStat = {};
+    ASSERT_EQ(stat(USER_INFO_FILE, &fileStat), 0);
+    EXPECT_EQ(static_cast<uint32_t>(fileStat.st_size), expectSize);
+
+    userList = LoadFileInfo();
+    ASSERT_NE(userList, nullptr);
+    EXPECT_EQ(userList->getSize(userList), USER_NUM);
+    for (uint32_t i = 0; i < USER_NUM; i++) {
+        UserInfo *user = FindUser(userList, static_cast<int32_t>(i));
+        ASSERT_NE(user, nullptr);
+        EXPECT_EQ(user->secUid, SEC_UID_BASE + i);
+        EXPECT_EQ(user->credentialInfoList->getSize(user->credentialInfoList), i + 1);
+        EXPECT_EQ(user->enrolledInfoList->getSize(user->enrolledInfoList), 1u);
+        EnrolledInfoHal *enrolled = static_cast<EnrolledInfoHal *>(user->enrolledInfoList->head->data);
+        EXPECT_EQ(enrolled->enrolledId, i);
+    }
+    DestroyLinkedList(userList);
+}
+} // namespace UserIAM
+} // namespace OHOS
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <initializer_list>
+
+#include "schedule_timeout_policy.h"
+
+using namespace testing::ext;
+namespace OHOS {
+namespace UserIAM {
+namespace CoAuth {
+namespace {
+const std::string TEST_CONFIG_PATH = "/data/schedule_timeout_test.conf";
+const std::string MISSING_CONFIG_PATH = "/data/schedule_timeout_missing.conf";
+// Only used by the adaptive timeout test, so that no rule and no other sample applies.
+constexpr uint32_t ADAPTIVE_AUTH_TYPE = 4;
+constexpr uint32_t ADAPTIVE_SAMPLE_NUM = 16;
+constexpr uint32_t TIMEOUT_SAMPLE_NUM = 40;
+constexpr int64_t MIN_ADAPTIVE_TIMEOUT_MS = 30000;
+
+ScheduleInfo CreateScheduleInfo(uint32_t authType, uint32_t scheduleMode, std::initializer_list<uint64_t> executorIds)
+{
+    ScheduleInfo scheduleInfo = {};
+    scheduleInfo.scheduleMode = scheduleMode;
+    for (uint64_t executorId : executorIds) {
+        ExecutorInfo executorInfo = {};
+        executorInfo.authType = authType;
+        executorInfo.executorId = executorId;
+        scheduleInfo.executors.push_back(executorInfo);
+    }
+    return scheduleInfo;
+}
+
+void WriteConfig(const std::string &content)
+{
+    std::ofstream file(TEST_CONFIG_PATH, std::ios::trunc);
+    file << content;
+}
+} // namespace
+
+class ScheduleTimeoutPolicyTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void ScheduleTimeoutPolicyTest::SetUpTestCase(void)
+{
+}
+
+void ScheduleTimeoutPolicyTest::TearDownTestCase(void)
+{
+    (void)remove(TEST_CONFIG_PATH.c_str());
+}
+
+// Every test starts without rules.
+void ScheduleTimeoutPolicyTest::SetUp()
+{
+    WriteConfig("");
+    ASSERT_TRUE(ScheduleTimeoutPolicy::GetInstance().LoadConfig(TEST_CONFIG_PATH));
+}
+
+void ScheduleTimeoutPolicyTest::TearDown()
+{
+    WriteConfig("");
+    (void)ScheduleTimeoutPolicy::GetInstance().LoadConfig(TEST_CONFIG_PATH);
+}
+
+/**
+ * @tc.name: ScheduleTimeoutPolicyTest001
+ * @tc.desc: Test that a schedule without a rule or samples gets the default timeout.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScheduleTimeoutPolicyTest, ScheduleTimeoutPolicyTest001, TestSize.Level0)
+{
+    ScheduleTimeoutPolicy &policy = ScheduleTimeoutPolicy::GetInstance();
+    EXPECT_FALSE(policy.LoadConfig(MISSING_CONFIG_PATH));
+    EXPECT_EQ(policy.BeginSchedule(1, CreateScheduleInfo(1, 1, { 5 })), delay_time);
+    policy.EndSchedule(1);
+}
+
+/**
+ * @tc.name: ScheduleTimeoutPolicyTest002
+ * @tc.desc: Test that the most specific rule wins and that invalid lines are skipped.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScheduleTimeoutPolicyTest, ScheduleTimeoutPolicyTest002, TestSize.Level0)
+{
+    WriteConfig("# authType scheduleMode executorId timeoutMs\n"
+        "1 1 * 60000\n"
+        "1 1 5 2000 # executor specific\n"
+        "1 1 7 4000\n"
+        "2 * * 9000\n"
+        "* * * 7000\n"
+        "bad line\n"
+        "3 * 4 abc\n"
+        "1 0 * 0\n"
+        "* 1 * 8000\n");
+    ScheduleTimeoutPolicy &policy = ScheduleTimeoutPolicy::GetInstance();
+    ASSERT_TRUE(policy.LoadConfig(TEST_CONFIG_PATH));
+    EXPECT_EQ(policy.BeginSchedule(1, CreateScheduleInfo(1, 1, { 5 })), 2000);
+    EXPECT_EQ(policy.BeginSchedule(2, CreateScheduleInfo(1, 1, { 6 })), 60000);
+    EXPECT_EQ(policy.BeginSchedule(3, CreateScheduleInfo(1, 1, { 5, 7 })), 4000);
+    EXPECT_EQ(policy.BeginSchedule(4, CreateScheduleInfo(2, 0, { 6 })), 9000);
+    EXPECT_EQ(policy.BeginSchedule(5, CreateScheduleInfo(3, 0, { 4 })), 7000);
+    EXPECT_EQ(policy.BeginSchedule(6, CreateScheduleInfo(1, 0, { 6 })), 7000);
+    for (uint64_t scheduleId = 1; scheduleId <= 6; scheduleId++) {
+        policy.EndSchedule(scheduleId);
+    }
+}
+
+/**
+ * @tc.name: ScheduleTimeoutPolicyTest003
+ * @tc.desc: Test that the timeout adapts to fast finishes and grows again when schedules time out.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScheduleTimeoutPolicyTest, ScheduleTimeoutPolicyTest003, TestSize.Level0)
+{
+    ScheduleTimeoutPolicy &policy = ScheduleTimeoutPolicy::GetInstance();
+    ScheduleInfo scheduleInfo = CreateScheduleInfo(ADAPTIVE_AUTH_TYPE, 1, { 1 });
+    uint64_t scheduleId = 100;
+    for (uint32_t i = 0; i < ADAPTIVE_SAMPLE_NUM; i++, scheduleId++) {
+        EXPECT_EQ(policy.BeginSchedule(scheduleId, scheduleInfo), delay_time);
+        policy.FinishSchedule(scheduleId);
+    }
+    EXPECT_EQ(policy.BeginSchedule(scheduleId, scheduleInfo), MIN_ADAPTIVE_TIMEOUT_MS);
+    // Ended schedules are no samples.
+    policy.EndSchedule(scheduleId);
+    policy.FinishSchedule(scheduleId++);
+    EXPECT_EQ(policy.BeginSchedule(scheduleId, scheduleInfo), MIN_ADAPTIVE_TIMEOUT_MS);
+    policy.EndSchedule(scheduleId++);
+
+    for (uint32_t i = 0; i < TIMEOUT_SAMPLE_NUM; i++, scheduleId++) {
+        (void)policy.BeginSchedule(scheduleId, scheduleInfo);
+        policy.TimeoutSchedule(scheduleId);
+    }
+    int64_t timeout = policy.BeginSchedule(scheduleId, scheduleInfo);
+    EXPECT_GT(timeout, MIN_ADAPTIVE_TIMEOUT_MS);
+    EXPECT_LE(timeout, delay_time * 2);
+    policy.EndSchedule(scheduleId);
+}
+} // namespace CoAuth
+} // namespace UserIAM
+} // namespace OHOS